@@ -0,0 +1,226 @@
+// Host benchmark: epoch-day core vs. the previous date functions
+//
+// Build and run from the repository root:
+//   g++ -O2 -Isrc src/datetime.cpp src/dst_table.cpp bench/bench_datetime.cpp -o bench_datetime
+//   ./bench_datetime > bench_output.txt
+//
+// Host timings only rank the implementations; on the AVR (no hardware divider)
+// the gap between division-heavy and table/multiply code is larger.
+//
+// Size proxy for the DST table (host -Os objects; avr-size on the firmware ELF
+// is the real number):
+//   g++ -Os -c -Isrc src/dst_table.cpp -o dst_table.o && nm -S --size-sort -C dst_table.o
+//   g++ -Os -c -Isrc src/datetime.cpp -o datetime.o && nm -S --size-sort -C datetime.o
+// dstTable is 200 bytes on every target (2 x uint16_t, 5 rules, 10 years). The
+// runtime path is getDSTSwitchDay() and what it calls: getNthWeekday,
+// getDayOfWeek, daysFromCivil, getDaysInMonth, getDayOfYear, isLeapYear.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+#include "datetime.h"
+#include "dst_table.h"
+
+// ============================================================================
+// LEGACY IMPLEMENTATIONS (as they were before the epoch-day core)
+// ============================================================================
+
+static uint8_t legacyGetDayOfWeek(uint16_t year, uint8_t month, uint8_t day) {
+  if (month < 3) {
+    month += 12;
+    year--;
+  }
+  uint16_t q = day;
+  uint16_t m = month;
+  uint16_t k = year % 100;
+  uint16_t j = year / 100;
+  uint16_t h = (q + ((13 * (m + 1)) / 5) + k + (k / 4) + (j / 4) - (2 * j)) % 7;
+  return (h + 6) % 7;
+}
+
+static uint8_t legacyGetNthSunday(uint16_t year, uint8_t month, int8_t n) {
+  uint8_t daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  if ((year % 4 == 0 && year % 100 != 0) || (year % 400 == 0)) {
+    daysInMonth[2] = 29;
+  }
+  if (n > 0) {
+    uint8_t dow = legacyGetDayOfWeek(year, month, 1);
+    uint8_t firstSunday = 1 + ((7 - dow) % 7);
+    return firstSunday + ((n - 1) * 7);
+  } else if (n == -1) {
+    uint8_t lastDay = daysInMonth[month];
+    uint8_t dow = legacyGetDayOfWeek(year, month, lastDay);
+    return lastDay - dow;
+  }
+  return 1;
+}
+
+// Next-day step from the old autoIncrementDate() (removed; the RTC keeps the calendar)
+static void legacyNextDay(uint16_t& year, uint8_t& month, uint8_t& day) {
+  uint8_t daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  if ((year % 4 == 0 && year % 100 != 0) || (year % 400 == 0)) {
+    daysInMonth[2] = 29;
+  }
+  day++;
+  if (day > daysInMonth[month]) {
+    day = 1;
+    month++;
+    if (month > 12) {
+      month = 1;
+      year++;
+    }
+  }
+}
+
+static void coreNextDay(uint16_t& year, uint8_t& month, uint8_t& day) {
+  civilFromDays(daysFromCivil(year, month, day) + 1, year, month, day);
+}
+
+// ============================================================================
+// HARNESS
+// ============================================================================
+
+#define FIRST_YEAR 2000
+#define LAST_YEAR  2099
+#define PASSES     20
+
+static volatile uint32_t sink;  // Keeps results alive under -O2
+
+typedef std::chrono::steady_clock Clock;
+
+static void report(const char* name, Clock::time_point t0, Clock::time_point t1, uint32_t calls) {
+  double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+  printf("%-26s %10u calls %8.2f ns/call\n", name, calls, ns / calls);
+}
+
+// Every day of FIRST_YEAR..LAST_YEAR, PASSES times
+template <typename Fn>
+static void benchDays(const char* name, Fn fn) {
+  uint32_t calls = 0, acc = 0;
+  Clock::time_point t0 = Clock::now();
+  for (int pass = 0; pass < PASSES; pass++) {
+    for (uint16_t y = FIRST_YEAR; y <= LAST_YEAR; y++) {
+      for (uint8_t m = 1; m <= 12; m++) {
+        uint8_t dim = getDaysInMonth(y, m);
+        for (uint8_t d = 1; d <= dim; d++) {
+          acc += fn(y, m, d);
+          calls++;
+        }
+      }
+    }
+  }
+  Clock::time_point t1 = Clock::now();
+  sink = acc;
+  report(name, t0, t1, calls);
+}
+
+// Nth Sunday for every month and n in {1, 2, 3, -1}
+template <typename Fn>
+static void benchSundays(const char* name, Fn fn) {
+  static const int8_t ns[] = {1, 2, 3, -1};
+  uint32_t calls = 0, acc = 0;
+  Clock::time_point t0 = Clock::now();
+  for (int pass = 0; pass < PASSES * 30; pass++) {
+    for (uint16_t y = FIRST_YEAR; y <= LAST_YEAR; y++) {
+      for (uint8_t m = 1; m <= 12; m++) {
+        for (uint8_t i = 0; i < 4; i++) {
+          acc += fn(y, m, ns[i]);
+          calls++;
+        }
+      }
+    }
+  }
+  Clock::time_point t1 = Clock::now();
+  sink = acc;
+  report(name, t0, t1, calls);
+}
+
+// Walk the whole range one day at a time
+template <typename Fn>
+static void benchWalk(const char* name, Fn fn) {
+  uint32_t calls = 0;
+  Clock::time_point t0 = Clock::now();
+  for (int pass = 0; pass < PASSES; pass++) {
+    uint16_t y = FIRST_YEAR;
+    uint8_t m = 1, d = 1;
+    while (y <= LAST_YEAR) {
+      fn(y, m, d);
+      calls++;
+    }
+    sink = y + m + d;
+  }
+  Clock::time_point t1 = Clock::now();
+  report(name, t0, t1, calls);
+}
+
+// Both transition days of every rule for every year of the DST table
+template <typename Fn>
+static void benchTransitions(const char* name, Fn fn) {
+  uint32_t calls = 0, acc = 0;
+  Clock::time_point t0 = Clock::now();
+  for (int pass = 0; pass < PASSES * 1000; pass++) {
+    for (uint16_t y = DST_TABLE_FIRST_YEAR; y <= DST_TABLE_LAST_YEAR; y++) {
+      for (uint8_t rule = 1; rule <= DST_TABLE_RULES; rule++) {
+        acc += fn(rule, y);
+        calls++;
+      }
+    }
+  }
+  Clock::time_point t1 = Clock::now();
+  sink = acc;
+  report(name, t0, t1, calls);
+}
+
+static uint32_t tableTransitionDays(uint8_t rule, uint16_t year) {
+  uint16_t start, end;
+  getDSTTransitionDays(rule, year, start, end);
+  return (uint32_t)start << 16 | end;
+}
+
+// The fallback getDSTTransitionDays() uses outside the table range
+static uint32_t runtimeTransitionDays(uint8_t rule, uint16_t year) {
+  DSTRule r;
+  getDSTRule(rule, r);
+  return (uint32_t)getDSTSwitchDay(r.start, year) << 16 | getDSTSwitchDay(r.end, year);
+}
+
+int main() {
+  // Correctness first: legacy Zeller wraps its uint16_t sum when
+  // k + k/4 + j/4 < 2j (e.g. 2000-03-01), so it disagrees on some dates
+  uint32_t dowMismatches = 0, sundayMismatches = 0;
+  for (uint16_t y = FIRST_YEAR; y <= LAST_YEAR; y++) {
+    for (uint8_t m = 1; m <= 12; m++) {
+      for (uint8_t d = 1; d <= getDaysInMonth(y, m); d++) {
+        if (legacyGetDayOfWeek(y, m, d) != getDayOfWeek(y, m, d)) dowMismatches++;
+      }
+      if (legacyGetNthSunday(y, m, 1) != getNthSunday(y, m, 1)) sundayMismatches++;
+      if (legacyGetNthSunday(y, m, -1) != getNthSunday(y, m, -1)) sundayMismatches++;
+    }
+  }
+  printf("legacy getDayOfWeek mismatches: %u days\n", dowMismatches);
+  printf("legacy getNthSunday mismatches: %u months\n", sundayMismatches);
+
+  uint32_t tableMismatches = 0;
+  for (uint16_t y = DST_TABLE_FIRST_YEAR; y <= DST_TABLE_LAST_YEAR; y++) {
+    for (uint8_t rule = 1; rule <= DST_TABLE_RULES; rule++) {
+      if (tableTransitionDays(rule, y) != runtimeTransitionDays(rule, y)) tableMismatches++;
+    }
+  }
+  printf("DST table mismatches vs. runtime: %u rule-years\n", tableMismatches);
+
+  printf("Years %d-%d, %d passes\n", FIRST_YEAR, LAST_YEAR, PASSES);
+  benchDays("legacy getDayOfWeek", legacyGetDayOfWeek);
+  benchDays("core   getDayOfWeek", getDayOfWeek);
+  benchDays("core   daysFromCivil", [](uint16_t y, uint8_t m, uint8_t d) {
+    return (uint32_t)daysFromCivil(y, m, d);
+  });
+  benchSundays("legacy getNthSunday", legacyGetNthSunday);
+  benchSundays("core   getNthSunday", getNthSunday);
+  benchWalk("legacy next day", legacyNextDay);
+  benchWalk("core   next day", coreNextDay);
+
+  printf("DST transition days %d-%d, %d rules\n", DST_TABLE_FIRST_YEAR, DST_TABLE_LAST_YEAR, DST_TABLE_RULES);
+  benchTransitions("runtime switch-day search", runtimeTransitionDays);
+  benchTransitions("flash table read", tableTransitionDays);
+  return 0;
+}
@@ -0,0 +1,129 @@
+// Host benchmark suite: every datetime.cpp kernel, swept over every day of a
+// year range, results as JSON so runs from two commits can be diffed
+//
+// Build and run from the repository root:
+//   g++ -O2 -Isrc src/datetime.cpp src/dst_table.cpp bench/bench_kernels.cpp -o bench_kernels
+//   ./bench_kernels [--from 2000] [--to 2099] [--passes 20] > bench_kernels.json
+//
+// Each result line is one kernel: calls, ns/call and calls/s. Host numbers are
+// only comparable between runs on the same machine and compiler (recorded in
+// the output). Before accepting a rewrite of the date math, run it on both
+// commits and compare ns_per_call.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <chrono>
+#include "datetime.h"
+
+static uint16_t firstYear = 2000;
+static uint16_t lastYear = 2099;
+static int passes = 20;
+
+static volatile uint32_t sink;  // Keeps results alive under -O2
+
+typedef std::chrono::steady_clock Clock;
+
+static bool firstResult = true;
+
+static void report(const char* name, Clock::time_point t0, Clock::time_point t1, uint32_t calls) {
+  double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+  double nsPerCall = ns / calls;
+  printf("%s    {\"name\": \"%s\", \"calls\": %u, \"ns_per_call\": %.3f, \"calls_per_s\": %.0f}",
+         firstResult ? "" : ",\n", name, calls, nsPerCall, 1e9 / nsPerCall);
+  firstResult = false;
+}
+
+// fn(y, m, d) for every day of the range, `passes` times
+template <typename Fn>
+static void benchDays(const char* name, Fn fn) {
+  uint32_t calls = 0, acc = 0;
+  Clock::time_point t0 = Clock::now();
+  for (int pass = 0; pass < passes; pass++) {
+    for (uint16_t y = firstYear; y <= lastYear; y++) {
+      for (uint8_t m = 1; m <= 12; m++) {
+        uint8_t dim = getDaysInMonth(y, m);
+        for (uint8_t d = 1; d <= dim; d++) {
+          acc += fn(y, m, d);
+          calls++;
+        }
+      }
+    }
+  }
+  Clock::time_point t1 = Clock::now();
+  sink = acc;
+  report(name, t0, t1, calls);
+}
+
+static bool parseArgs(int argc, char** argv) {
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--from") == 0) firstYear = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "--to") == 0) lastYear = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "--passes") == 0) passes = atoi(argv[i + 1]);
+    else return false;
+  }
+  return (argc % 2) == 1 && firstYear >= 1 && firstYear <= lastYear && lastYear <= 9999 && passes > 0;
+}
+
+int main(int argc, char** argv) {
+  if (!parseArgs(argc, argv)) {
+    fprintf(stderr, "usage: %s [--from year] [--to year] [--passes n]\n", argv[0]);
+    return 1;
+  }
+
+  printf("{\n");
+  printf("  \"suite\": \"datetime\",\n");
+  printf("  \"compiler\": \"%s\",\n", __VERSION__);
+  printf("  \"from\": %u, \"to\": %u, \"passes\": %d,\n", firstYear, lastYear, passes);
+  printf("  \"results\": [\n");
+
+  // Kernels named in the request first, then the rest of datetime.h
+  benchDays("getDayOfWeek", getDayOfWeek);
+  benchDays("getNthSunday", [](uint16_t y, uint8_t m, uint8_t d) {
+    // n cycles through 1, 2, 3, -1 (last) as the DST rules use it
+    static const int8_t ns[] = {1, 2, 3, -1};
+    return getNthSunday(y, m, ns[d & 3]);
+  });
+  benchDays("format12Hour", [](uint16_t, uint8_t, uint8_t d) {
+    return format12Hour(d % 24);
+  });
+  benchDays("isDSTActive_USA_Canada", isDSTActive_USA_Canada);
+  benchDays("isDSTActive_UK", isDSTActive_UK);
+  benchDays("isDSTActive_Australia", isDSTActive_Australia);
+  benchDays("isDSTActive_NewZealand", isDSTActive_NewZealand);
+  benchDays("isDSTActive_Brazil", isDSTActive_Brazil);
+  benchDays("isLeapYear", [](uint16_t y, uint8_t, uint8_t) {
+    return isLeapYear(y);
+  });
+  benchDays("getDaysInMonth", [](uint16_t y, uint8_t m, uint8_t) {
+    return getDaysInMonth(y, m);
+  });
+  benchDays("daysFromCivil", [](uint16_t y, uint8_t m, uint8_t d) {
+    return (uint32_t)daysFromCivil(y, m, d);
+  });
+  benchDays("civilFromDays", [](uint16_t y, uint8_t m, uint8_t d) {
+    // Round trip: includes one daysFromCivil
+    uint16_t year;
+    uint8_t month, day;
+    civilFromDays(daysFromCivil(y, m, d), year, month, day);
+    return (uint32_t)(year + month + day);
+  });
+  benchDays("addMinutes", [](uint16_t y, uint8_t m, uint8_t d) {
+    uint8_t hour = 23, minute = 30;
+    addMinutes(y, m, d, hour, minute, 90);  // Always carries into the next day
+    return (uint32_t)(y + m + d + hour);
+  });
+  benchDays("getDayOfYear", getDayOfYear);
+  benchDays("getSecondsOfYear", [](uint16_t y, uint8_t m, uint8_t d) {
+    return getSecondsOfYear(y, m, d, 12, 0, 0);
+  });
+  benchDays("getDSTTransitions", [](uint16_t y, uint8_t m, uint8_t d) {
+    uint32_t start, end;
+    getDSTTransitions(1 + (m + d) % 5, y, -300, start, end);
+    return start ^ end;
+  });
+
+  printf("\n  ]\n}\n");
+  return 0;
+}
@@ -0,0 +1,95 @@
+// Host benchmark: table-driven command parser vs. the previous sscanf/atoi parsing
+//
+// Build and run from the repository root:
+//   g++ -O2 -Isrc src/command.cpp src/datetime.cpp src/dst_table.cpp bench/bench_parser.cpp -o bench_parser
+//   ./bench_parser > bench_output.txt
+//
+// Host timings only rank the implementations. On the AVR, avr-libc's vfscanf
+// is far slower per call than on a desktop libc, and dropping it is where the
+// flash saving comes from (check with avr-size before/after).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include "command.h"
+#include "datetime.h"
+
+// ============================================================================
+// LEGACY PARSING (as in handleSerial() before the parser module)
+// ============================================================================
+
+static bool legacyParse(const char* buf, int* a, int* b, int* c) {
+  if (buf[0] == 'T') {
+    return sscanf(buf + 1, "%d,%d,%d", a, b, c) == 3 &&
+           *a >= 0 && *a <= 23 && *b >= 0 && *b <= 59 && *c >= 0 && *c <= 59;
+  }
+  if (buf[0] == 'D') {
+    return sscanf(buf + 1, "%d,%d,%d", a, b, c) == 3 &&
+           *c >= 2000 && *c <= 2099 && *a >= 1 && *a <= 12 &&
+           *b >= 1 && *b <= getDaysInMonth(*c, *a);
+  }
+  if (buf[0] == 'N' || buf[0] == 'Y') {
+    return sscanf(buf + 1, "%d,%d,%d", a, b, c) == 3 &&
+           *a >= 0 && *a <= 23 && *b >= 0 && *b <= 59 && *c >= 0 && *c <= 7;
+  }
+  if (buf[0] == 'F') {
+    return sscanf(buf + 1, "%d", a) == 1 && (*a == 0 || *a == 1);
+  }
+  if (buf[0] == 'B') {
+    *a = atoi(buf + 1);
+    return *a >= 0 && *a <= 7;
+  }
+  if (buf[0] == 'Z') {
+    *a = atoi(buf + 1);
+    return *a >= 0 && *a <= 20;
+  }
+  return false;
+}
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+static volatile uint32_t sink;  // Keeps results alive under -O2
+
+typedef std::chrono::steady_clock Clock;
+
+static const char* const lines[] = {
+  "T12,34,56", "D3,15,2026", "N22,30,1", "Y7,0,5", "F1", "B5", "Z14",
+};
+#define LINE_COUNT (sizeof(lines) / sizeof(lines[0]))
+#define ITERATIONS 1000000
+
+int main() {
+  // Both parsers must agree on the sample lines
+  for (uint8_t i = 0; i < LINE_COUNT; i++) {
+    int a, b, c;
+    Command cmd;
+    if (!legacyParse(lines[i], &a, &b, &c) || parseCommand(lines[i], cmd) != PARSE_OK ||
+        cmd.args[0] != a) {
+      printf("mismatch on %s\n", lines[i]);
+      return 1;
+    }
+  }
+
+  printf("%-12s %14s %14s\n", "line", "sscanf ns", "table ns");
+  for (uint8_t i = 0; i < LINE_COUNT; i++) {
+    Clock::time_point t0 = Clock::now();
+    for (uint32_t n = 0; n < ITERATIONS; n++) {
+      int a, b, c;
+      sink += legacyParse(lines[i], &a, &b, &c) ? a : 0;
+    }
+    Clock::time_point t1 = Clock::now();
+    for (uint32_t n = 0; n < ITERATIONS; n++) {
+      Command cmd;
+      sink += parseCommand(lines[i], cmd) == PARSE_OK ? cmd.args[0] : 0;
+    }
+    Clock::time_point t2 = Clock::now();
+
+    double legacyNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / ITERATIONS;
+    double tableNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / ITERATIONS;
+    printf("%-12s %14.2f %14.2f\n", lines[i], legacyNs, tableNs);
+  }
+  return 0;
+}
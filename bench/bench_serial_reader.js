@@ -0,0 +1,201 @@
+// Host benchmark: the dashboard's streaming serial reader (www/serial_reader.js)
+// vs. the previous per-byte string reader, fed from a recorded byte stream
+//
+// Run from the repository root (node 16 or later):
+//   node bench/bench_serial_reader.js [--passes 200] [--chunk 64] > bench_serial.json
+//
+// bench/serial_capture.bin is the firmware's output (native simulator, default
+// verbosity) for 40 rounds of the dashboard's queries and settings, a J probe,
+// two binary frames with their reply frames, and 30 s of ticks: DBG, OK and ERR
+// lines with CR LF, and 0xA5 frames in between. Chunks are cut at --chunk bytes,
+// like the pieces a Web Serial reader returns.
+//
+// "console" models the log panel: the previous code rebuilt the HTML of every
+// message so far for each new line, the new one builds one row and keeps the
+// last 500. Strings stand in for the DOM, so it only shows how each grows with
+// the length of a session, not browser timings.
+
+'use strict';
+
+const fs = require('fs');
+const path = require('path');
+const { SerialLineReader } = require('../www/serial_reader.js');
+
+const FRAME_SYNC = 0xA5;
+const FRAME_MAX_BODY = 24;
+const BAUD = 115200;
+
+// ============================================================================
+// LEGACY READER (readLoop() in index.html before serial_reader.js)
+// ============================================================================
+
+function legacyReader(onLine, onFrame) {
+    let serialRxBuffer = '';
+    let rxFrame = null;
+    return chunk => {
+        for (const byte of chunk) {
+            if (rxFrame) {
+                rxFrame.push(byte);
+                const len = rxFrame[1];
+                if (len === 0 || len > FRAME_MAX_BODY) {
+                    rxFrame = null;
+                } else if (rxFrame.length === len + 4) {
+                    onFrame(rxFrame);
+                    rxFrame = null;
+                }
+                continue;
+            }
+            if (byte === FRAME_SYNC && serialRxBuffer === '') {
+                rxFrame = [byte];
+                continue;
+            }
+            if (byte === 0x0A || byte === 0x0D) {
+                const line = serialRxBuffer.trim();
+                serialRxBuffer = '';
+                if (line) onLine(line);  // handleArduinoLine() ignored empty lines
+                continue;
+            }
+            serialRxBuffer += String.fromCharCode(byte);
+        }
+    };
+}
+
+function streamingReader(onLine, onFrame) {
+    const reader = new SerialLineReader({ onLine, onFrame, maxFrameBody: FRAME_MAX_BODY });
+    return chunk => reader.push(chunk);
+}
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+function parseArgs(argv) {
+    const opts = { passes: 200, chunk: 64 };
+    for (let i = 2; i + 1 < argv.length; i += 2) {
+        const value = parseInt(argv[i + 1], 10);
+        if (argv[i] === '--passes' && value > 0) opts.passes = value;
+        else if (argv[i] === '--chunk' && value > 0) opts.chunk = value;
+        else {
+            console.error('usage: node bench/bench_serial_reader.js [--passes n] [--chunk bytes]');
+            process.exit(2);
+        }
+    }
+    return opts;
+}
+
+function chunksOf(bytes, size) {
+    const chunks = [];
+    for (let i = 0; i < bytes.length; i += size) chunks.push(bytes.subarray(i, i + size));
+    return chunks;
+}
+
+// Everything a reader reports for the capture, as one comparable list
+function decode(makeReader, chunks) {
+    const out = [];
+    const push = makeReader(line => out.push(line), frame => out.push('frame ' + Array.from(frame).join(' ')));
+    for (const chunk of chunks) push(chunk);
+    return out;
+}
+
+function sameOutput(a, b) {
+    return a.length === b.length && a.every((item, i) => item === b[i]);
+}
+
+const results = [];
+
+function report(name, bytes, ns, extra) {
+    const mbPerS = bytes / ns * 1e3;
+    results.push(Object.assign({
+        name,
+        bytes,
+        ns_per_byte: +(ns / bytes).toFixed(3),
+        mb_per_s: +mbPerS.toFixed(2),
+        x_115200: Math.round(mbPerS * 1e6 / (BAUD / 10))
+    }, extra));
+}
+
+function benchReader(name, makeReader, chunks, totalBytes, passes) {
+    let lines = 0;
+    const push = makeReader(() => lines++, () => {});
+    for (const chunk of chunks) push(chunk);  // Warm-up pass
+    const t0 = process.hrtime.bigint();
+    for (let pass = 0; pass < passes; pass++) {
+        for (const chunk of chunks) push(chunk);
+    }
+    const ns = Number(process.hrtime.bigint() - t0);
+    report(name, totalBytes * passes, ns, { lines: lines / (passes + 1) });
+}
+
+// Log panel cost per line over a session of `count` lines
+function benchConsole(name, lines, count, addLine) {
+    const t0 = process.hrtime.bigint();
+    let size = 0;
+    for (let i = 0; i < count; i++) size += addLine(lines[i % lines.length]);
+    const ns = Number(process.hrtime.bigint() - t0);
+    results.push({ name, lines: count, ns_per_line: Math.round(ns / count), chars_built: size });
+}
+
+function legacyConsole() {
+    const messageLog = [];
+    return msg => {
+        messageLog.push(msg);
+        const html = messageLog
+            .map((m, idx) => `<div><span class="text-neutral-600">[${idx + 1}]</span> ${m}</div>`)
+            .join('');
+        return html.length;
+    };
+}
+
+function appendConsole() {
+    const rows = [];
+    let count = 0;
+    return msg => {
+        const row = `<div><span class="text-neutral-600">[${++count}]</span> ${msg}</div>`;
+        rows.push(row);
+        if (rows.length > 500) rows.shift();
+        return row.length;
+    };
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+const opts = parseArgs(process.argv);
+const capture = new Uint8Array(fs.readFileSync(path.join(__dirname, 'serial_capture.bin')));
+
+// Both readers must agree on every line and frame, whatever the chunking
+let identical = true;
+const reference = decode(legacyReader, [capture]);
+for (const size of [1, 7, opts.chunk, capture.length]) {
+    const chunks = chunksOf(capture, size);
+    identical = identical && sameOutput(reference, decode(legacyReader, chunks)) &&
+                sameOutput(reference, decode(streamingReader, chunks));
+}
+if (!identical) {
+    console.error('readers disagree on the capture');
+    process.exit(1);
+}
+
+const chunks = chunksOf(capture, opts.chunk);
+benchReader('reader_legacy', legacyReader, chunks, capture.length, opts.passes);
+benchReader('reader_streaming', streamingReader, chunks, capture.length, opts.passes);
+
+const lines = reference.filter(item => !item.startsWith('frame '));
+for (const count of [500, 2000, 5000]) {
+    benchConsole(`console_legacy_${count}`, lines, count, legacyConsole());
+    benchConsole(`console_append_${count}`, lines, count, appendConsole());
+}
+
+const out = {
+    suite: 'serial_reader',
+    node: process.version,
+    capture_bytes: capture.length,
+    capture_lines: lines.length,
+    capture_frames: reference.length - lines.length,
+    chunk: opts.chunk,
+    passes: opts.passes,
+    identical,
+    results
+};
+process.stdout.write(JSON.stringify(out, null, 2) + '\n');
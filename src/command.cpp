@@ -0,0 +1,235 @@
+#include "command.h"
+#include <string.h>
+#include "datetime.h"
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#define memcpy_P memcpy
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#endif
+
+// Argument types: each one is an inclusive range
+#define ARG_HOUR   0  // 0-23
+#define ARG_MINUTE 1  // 0-59 (also seconds)
+#define ARG_MONTH  2  // 1-12
+#define ARG_DAY    3  // 1-31, checked against the month afterwards
+#define ARG_YEAR   4  // CMD_MIN_YEAR-CMD_MAX_YEAR
+#define ARG_FLAG   5  // 0-1
+#define ARG_LEVEL  6  // 0-7 (brightness)
+#define ARG_TZ     7  // 0-CMD_TZ_ID_MAX
+#define ARG_BAUD   8  // 96-1152, checked against the supported rates afterwards
+#define ARG_LEVEL3 9  // 0-2 (verbosity)
+#define ARG_PROBE  10 // 0-(TIME_PROBE_SLOTS-1)
+#define ARG_DELAY  11 // 0-TIME_SET_MAX_DELAY_MS
+#define ARG_AGING  12 // -128-127 (signed byte)
+
+struct ArgBounds {
+  int16_t min;
+  int16_t max;
+};
+
+static const ArgBounds argBounds[] PROGMEM = {
+  {0, 23}, {0, 59}, {1, 12}, {1, 31}, {CMD_MIN_YEAR, CMD_MAX_YEAR}, {0, 1}, {0, 7},
+  {0, CMD_TZ_ID_MAX}, {96, 1152}, {VERBOSITY_SILENT, VERBOSITY_DEBUG},
+  {0, TIME_PROBE_SLOTS - 1}, {0, TIME_SET_MAX_DELAY_MS}, {-128, 127},
+};
+
+// Argument type lists, shared by commands with the same shape
+static const uint8_t argTypes[] PROGMEM = {
+  // 0: h,m,s
+  ARG_HOUR, ARG_MINUTE, ARG_MINUTE,
+  // 3: m,d,y
+  ARG_MONTH, ARG_DAY, ARG_YEAR,
+  // 6: h,m,b
+  ARG_HOUR, ARG_MINUTE, ARG_LEVEL,
+  // 9-11: single arguments
+  ARG_FLAG, ARG_LEVEL, ARG_TZ,
+  // 12: baud / 100
+  ARG_BAUD,
+  // 13: verbosity
+  ARG_LEVEL3,
+  // 14: sync all
+  ARG_MONTH, ARG_DAY, ARG_YEAR, ARG_HOUR, ARG_MINUTE, ARG_MINUTE, ARG_FLAG, ARG_TZ,
+  ARG_LEVEL, ARG_FLAG, ARG_HOUR, ARG_MINUTE, ARG_LEVEL, ARG_HOUR, ARG_MINUTE, ARG_LEVEL,
+  // 30: precise time set (J uses the first)
+  ARG_PROBE, ARG_DELAY, ARG_MONTH, ARG_DAY, ARG_YEAR, ARG_HOUR, ARG_MINUTE, ARG_MINUTE,
+  // 38: aging offset
+  ARG_AGING,
+};
+
+struct CommandSpec {
+  char name[2];     // One or two letters; name[1] = '\0' for single-letter commands
+  uint8_t op;       // CMD_*
+  uint8_t argc;     // Exact number of arguments
+  uint8_t argList;  // Index of the first argument type in argTypes[]
+};
+
+// Two-letter names come first so a query never matches a single-letter command
+static const CommandSpec commandTable[] PROGMEM = {
+  {{'Q', 'F'}, CMD_QUERY_FORMAT,   0, 0},
+  {{'Q', 'S'}, CMD_QUERY_SCHEDULE, 0, 0},
+  {{'Q', 'T'}, CMD_QUERY_TICK,     0, 0},
+  {{'Q', 'D'}, CMD_QUERY_DISPLAY,  0, 0},
+  {{'Q', 'V'}, CMD_QUERY_VERBOSITY, 0, 0},
+  {{'Q', 'C'}, CMD_QUERY_COUNTERS, 0, 0},
+  {{'R', 'C'}, CMD_RESET_COUNTERS, 0, 0},
+  {{'Q', 'G'}, CMD_QUERY_AGING,    0, 0},
+  {{'T', 0},   CMD_TIME,           3, 0},
+  {{'D', 0},   CMD_DATE,           3, 3},
+  {{'F', 0},   CMD_FORMAT,         1, 9},
+  {{'Z', 0},   CMD_TIMEZONE,       1, 11},
+  {{'B', 0},   CMD_BRIGHTNESS,     1, 10},
+  {{'S', 0},   CMD_SCHEDULE,       1, 9},
+  {{'N', 0},   CMD_NIGHT,          3, 6},
+  {{'Y', 0},   CMD_DAY,            3, 6},
+  {{'A', 0},   CMD_SYNC_ALL,       CMD_SYNC_ALL_ARGS, 14},
+  {{'H', 0},   CMD_HANDSHAKE,      0, 0},
+  {{'U', 0},   CMD_SET_BAUD,       1, 12},
+  {{'P', 0},   CMD_PING,           0, 0},
+  {{'V', 0},   CMD_VERBOSITY,      1, 13},
+  {{'J', 0},   CMD_TIME_PROBE,     1, 30},
+  {{'W', 0},   CMD_TIME_SET_AT,    CMD_TIME_SET_ARGS, 30},
+  {{'G', 0},   CMD_AGING,          1, 38},
+  {{'K', 0},   CMD_NIGHT_BLANK,    1, 9},
+};
+#define COMMAND_COUNT (sizeof(commandTable) / sizeof(commandTable[0]))
+
+// Parse one decimal integer at *p (optional leading spaces and '-'), advancing *p past it.
+// Returns false if there is no digit or the value does not fit in int16_t.
+static bool parseInt(const char*& p, int16_t& value) {
+  while (*p == ' ') p++;
+  bool negative = false;
+  if (*p == '-') {
+    negative = true;
+    p++;
+  }
+  if (*p < '0' || *p > '9') return false;
+  int32_t v = 0;
+  while (*p >= '0' && *p <= '9') {
+    v = v * 10 + (*p - '0');
+    if (v > 32767) return false;
+    p++;
+  }
+  value = negative ? -v : v;
+  return true;
+}
+
+// Argument type of argument a of a command
+static uint8_t argType(const CommandSpec& spec, uint8_t a) {
+  return pgm_read_byte(&argTypes[spec.argList + a]);
+}
+
+// Range check of one argument
+static bool argInRange(const CommandSpec& spec, uint8_t a, int16_t value) {
+  ArgBounds bounds;
+  memcpy_P(&bounds, &argBounds[argType(spec, a)], sizeof(bounds));
+  return value >= bounds.min && value <= bounds.max;
+}
+
+uint32_t baudFromCode(int16_t code) {
+  switch (code) {
+    case 96:   return 9600;
+    case 192:  return 19200;
+    case 384:  return 38400;
+    case 576:  return 57600;
+    case 1152: return 115200;
+    default:   return 0;
+  }
+}
+
+bool commandAlwaysReplies(uint8_t op) {
+  switch (op) {
+    case CMD_QUERY_FORMAT:
+    case CMD_QUERY_SCHEDULE:
+    case CMD_QUERY_TICK:
+    case CMD_QUERY_DISPLAY:
+    case CMD_QUERY_VERBOSITY:
+    case CMD_QUERY_COUNTERS:
+    case CMD_QUERY_AGING:
+    case CMD_HANDSHAKE:
+    case CMD_SET_BAUD:
+    case CMD_PING:
+    case CMD_VERBOSITY:
+    case CMD_TIME_PROBE:
+    case CMD_TIME_SET_AT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Bounds that depend on other arguments (D and A start with m,d,y) or are not a range
+static bool argsConsistent(const Command& cmd) {
+  if (cmd.op == CMD_DATE || cmd.op == CMD_SYNC_ALL) {
+    return cmd.args[1] <= getDaysInMonth(cmd.args[2], cmd.args[0]);
+  }
+  if (cmd.op == CMD_TIME_SET_AT) {
+    return cmd.args[TSET_DAY] <= getDaysInMonth(cmd.args[TSET_YEAR], cmd.args[TSET_MONTH]);
+  }
+  if (cmd.op == CMD_SET_BAUD) {
+    return baudFromCode(cmd.args[0]) != 0;
+  }
+  return true;
+}
+
+uint8_t parseCommand(const char* line, Command& cmd) {
+  cmd.op = CMD_NONE;
+  cmd.argc = 0;
+  if (!line) return PARSE_UNKNOWN;
+
+  // Find the command by name
+  CommandSpec spec;
+  uint8_t i = 0;
+  for (; i < COMMAND_COUNT; i++) {
+    memcpy_P(&spec, &commandTable[i], sizeof(spec));
+    if (line[0] == spec.name[0] && (spec.name[1] == '\0' || line[1] == spec.name[1])) break;
+  }
+  if (i == COMMAND_COUNT) return PARSE_UNKNOWN;
+  cmd.op = spec.op;
+
+  // Tokenize the arguments in place
+  const char* p = line + (spec.name[1] == '\0' ? 1 : 2);
+  for (uint8_t a = 0; a < spec.argc; a++) {
+    if (a > 0 && *p++ != ',') return PARSE_BAD_ARGS;
+    if (!parseInt(p, cmd.args[a])) return PARSE_BAD_ARGS;
+    if (!argInRange(spec, a, cmd.args[a])) return PARSE_BAD_ARGS;
+    cmd.argc++;
+  }
+  if (*p != '\0') return PARSE_BAD_ARGS;
+  return argsConsistent(cmd) ? PARSE_OK : PARSE_BAD_ARGS;
+}
+
+uint8_t decodeCommand(const uint8_t* body, uint8_t len, Command& cmd) {
+  cmd.op = CMD_NONE;
+  cmd.argc = 0;
+  if (len == 0) return PARSE_UNKNOWN;
+
+  // Find the command by opcode
+  CommandSpec spec;
+  uint8_t i = 0;
+  for (; i < COMMAND_COUNT; i++) {
+    memcpy_P(&spec, &commandTable[i], sizeof(spec));
+    if (spec.op == body[0]) break;
+  }
+  if (i == COMMAND_COUNT) return PARSE_UNKNOWN;
+  cmd.op = spec.op;
+
+  // Fixed-width fields: one byte each, years, baud codes and delays two bytes big-endian
+  uint8_t pos = 1;
+  for (uint8_t a = 0; a < spec.argc; a++) {
+    uint8_t type = argType(spec, a);
+    uint8_t width = (type == ARG_YEAR || type == ARG_BAUD || type == ARG_DELAY) ? 2 : 1;
+    if (pos + width > len) return PARSE_BAD_ARGS;
+    int16_t value = type == ARG_AGING ? (int8_t)body[pos] : body[pos];
+    // Assembled unsigned: a shifted int16_t overflows (undefined) on 16-bit int targets
+    if (width == 2) value = (int16_t)(uint16_t)((uint16_t)body[pos] << 8 | body[pos + 1]);
+    pos += width;
+    if (!argInRange(spec, a, value)) return PARSE_BAD_ARGS;
+    cmd.args[a] = value;
+    cmd.argc++;
+  }
+  if (pos != len) return PARSE_BAD_ARGS;
+  return argsConsistent(cmd) ? PARSE_OK : PARSE_BAD_ARGS;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <stdint.h>
+
+// Serial command parser: one text line or one binary frame body in, one opcode
+// plus range-checked integer arguments out. Commands are described by a compact table (name, argument
+// count, per-argument bounds) and arguments are tokenized in place, without
+// copying the line or calling scanf. No hardware dependencies: the firmware
+// and the native tests link the same code.
+
+#define CMD_MAX_ARGS 16
+
+// Opcodes (Command::op)
+#define CMD_NONE           0
+#define CMD_TIME           1   // T<h>,<m>,<s>      local time
+#define CMD_DATE           2   // D<m>,<d>,<y>      local date
+#define CMD_FORMAT         3   // F<0|1>            24h / 12h
+#define CMD_TIMEZONE       4   // Z<id>             timezone ID
+#define CMD_BRIGHTNESS     5   // B<0-7>            display brightness
+#define CMD_SCHEDULE       6   // S<0|1>            scheduled dimming on/off
+#define CMD_NIGHT          7   // N<h>,<m>,<b>      dim time and brightness
+#define CMD_DAY            8   // Y<h>,<m>,<b>      bright time and brightness
+#define CMD_QUERY_FORMAT   9   // QF
+#define CMD_QUERY_SCHEDULE 10  // QS
+#define CMD_QUERY_TICK     11  // QT
+#define CMD_QUERY_DISPLAY  12  // QD
+#define CMD_SYNC_ALL       13  // A<m>,<d>,<y>,<h>,<mi>,<s>,<f>,<z>,<b>,<e>,<nh>,<nm>,<nb>,<yh>,<ym>,<yb>
+#define CMD_HANDSHAKE      14  // H                 protocol version and features
+#define CMD_SET_BAUD       15  // U<baud/100>       switch the serial rate (verified by P)
+#define CMD_PING           16  // P                 link check
+#define CMD_VERBOSITY      17  // V<0-2>            output level (VERBOSITY_*)
+#define CMD_QUERY_VERBOSITY 18 // QV
+#define CMD_QUERY_COUNTERS 19  // QC                performance counters
+#define CMD_RESET_COUNTERS 20  // RC
+#define CMD_TIME_PROBE     21  // J<slot>           timestamped probe (precise time set)
+#define CMD_TIME_SET_AT    22  // W<slot>,<ms>,<m>,<d>,<y>,<h>,<mi>,<s>  UTC, <ms> after probe <slot>
+#define CMD_AGING          23  // G<-128..127>      DS3231 aging offset
+#define CMD_QUERY_AGING    24  // QG
+#define CMD_NIGHT_BLANK    25  // K<0|1>            blank the display in the dim period
+
+// Argument positions of the A (sync all) command: local date and time, then
+// the same values as F, Z, B, S, N and Y
+#define SYNC_MONTH         0
+#define SYNC_DAY           1
+#define SYNC_YEAR          2
+#define SYNC_HOUR          3
+#define SYNC_MINUTE        4
+#define SYNC_SECOND        5
+#define SYNC_FORMAT        6
+#define SYNC_TZ            7
+#define SYNC_BRIGHTNESS    8
+#define SYNC_SCHEDULE      9
+#define SYNC_DIM_HOUR      10
+#define SYNC_DIM_MINUTE    11
+#define SYNC_DIM_LEVEL     12
+#define SYNC_BRIGHT_HOUR   13
+#define SYNC_BRIGHT_MINUTE 14
+#define SYNC_BRIGHT_LEVEL  15
+#define CMD_SYNC_ALL_ARGS  16
+
+// Argument positions of the W (precise time set) command
+#define TSET_SLOT          0
+#define TSET_DELAY_MS      1
+#define TSET_MONTH         2
+#define TSET_DAY           3
+#define TSET_YEAR          4
+#define TSET_HOUR          5
+#define TSET_MINUTE        6
+#define TSET_SECOND        7
+#define CMD_TIME_SET_ARGS  8
+
+// Precise time set: J probe slots, and how far after its probe a W may schedule the write
+#define TIME_PROBE_SLOTS      8
+#define TIME_SET_MAX_DELAY_MS 10000
+
+// Protocol version and feature bits reported by H
+#define PROTOCOL_VERSION        1
+#define PROTOCOL_FEATURE_BINARY 0x01  // Binary frames (frame.h)
+#define PROTOCOL_FEATURE_BAUD   0x02  // U / P baud negotiation
+#define PROTOCOL_FEATURE_TIMESET 0x04  // J / W precise time set
+#define PROTOCOL_FEATURE_BLANK  0x08  // K night blanking
+
+// Output levels set by V: what the firmware prints besides query replies
+#define VERBOSITY_SILENT 0  // Only replies that carry data (see commandAlwaysReplies)
+#define VERBOSITY_ACK    1  // Plus OK/ERR for every command
+#define VERBOSITY_DEBUG  2  // Plus DBG lines (default)
+
+// Highest timezone ID accepted by Z (main.cpp checks this against its table)
+#define CMD_TZ_ID_MAX 22
+
+// Years accepted by D (DS3231 calendar range)
+#define CMD_MIN_YEAR 2000
+#define CMD_MAX_YEAR 2099
+
+// Serial rate of a U argument (baud / 100): 96, 192, 384, 576 or 1152.
+// Returns 0 for any other value.
+uint32_t baudFromCode(int16_t code);
+
+// True for commands that reply even at VERBOSITY_SILENT: queries, H, U, P, V, J and W
+bool commandAlwaysReplies(uint8_t op);
+
+// parseCommand() results
+#define PARSE_OK       0
+#define PARSE_UNKNOWN  1  // No command matches the line
+#define PARSE_BAD_ARGS 2  // Known command (cmd.op is set), but wrong syntax or out of range
+
+struct Command {
+  uint8_t op;                  // CMD_*
+  uint8_t argc;                // Number of arguments parsed
+  int16_t args[CMD_MAX_ARGS];  // In command order, e.g. h, m, s for T (SYNC_* for A)
+};
+
+// Parse a NUL-terminated line (without the line terminator). Arguments are
+// decimal integers separated by commas; spaces before a number are allowed.
+// On PARSE_BAD_ARGS, cmd.op still identifies the command for the error reply.
+uint8_t parseCommand(const char* line, Command& cmd);
+
+// Decode the body of a binary frame (see frame.h): the opcode (CMD_*), then one
+// byte per argument in text order, except years, baud codes and W delays which
+// take two bytes, big-endian. The G offset is one signed (two's complement) byte.
+// Same results and range checks as parseCommand().
+uint8_t decodeCommand(const uint8_t* body, uint8_t len, Command& cmd);
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <stdint.h>
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), bitwise to keep flash small.
+// Pass the previous result as crc to continue over several buffers.
+uint16_t crc16(const uint8_t* data, uint16_t len, uint16_t crc = 0xFFFF);
@@ -1,4 +1,5 @@
 #include "datetime.h"
+#include "dst_table.h"
 
 // Convert 24-hour (0-23) to 12-hour (1-12)
 uint8_t format12Hour(uint8_t hour24) {
@@ -7,155 +8,168 @@ uint8_t format12Hour(uint8_t hour24) {
   return hour24;  // 1-12 (AM)
 }
 
+// Gregorian leap year
+bool isLeapYear(uint16_t year) {
+  return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+}
+
+// Number of days in a month (1-12)
+uint8_t getDaysInMonth(uint16_t year, uint8_t month) {
+  static const uint8_t daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return (month == 2 && isLeapYear(year)) ? 29 : daysInMonth[month];
+}
+
+// Days since 1970-01-01 (Howard Hinnant's days_from_civil).
+// Shifting the year to start in March puts the leap day last, so the day of
+// year follows from one multiply/divide and no month table is needed.
+int32_t daysFromCivil(uint16_t year, uint8_t month, uint8_t day) {
+  year -= month <= 2;
+  uint16_t era = year / 400;
+  uint16_t yoe = year - era * 400;                                          // [0, 399]
+  uint16_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;  // [0, 365]
+  uint32_t doe = (uint32_t)yoe * 365 + yoe / 4 - yoe / 100 + doy;          // [0, 146096]
+  return (int32_t)era * 146097L + (int32_t)doe - 719468L;
+}
+
+// Inverse of daysFromCivil (Howard Hinnant's civil_from_days)
+void civilFromDays(int32_t days, uint16_t& year, uint8_t& month, uint8_t& day) {
+  days += 719468L;
+  uint16_t era = days / 146097L;
+  uint32_t doe = (uint32_t)(days - (int32_t)era * 146097L);                 // [0, 146096]
+  uint16_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;   // [0, 399]
+  uint16_t doy = doe - ((uint32_t)yoe * 365 + yoe / 4 - yoe / 100);        // [0, 365]
+  uint8_t mp = (5 * doy + 2) / 153;                                        // [0, 11], March = 0
+  day = doy - (153 * mp + 2) / 5 + 1;
+  month = mp < 10 ? mp + 3 : mp - 9;
+  year = yoe + era * 400 + (month <= 2);
+}
+
 // Calculate day of week (0=Sunday, 1=Monday, ..., 6=Saturday)
-// Uses Zeller's congruence algorithm
+// 1970-01-01 was a Thursday
 uint8_t getDayOfWeek(uint16_t year, uint8_t month, uint8_t day) {
-  if (month < 3) {
-    month += 12;
-    year--;
-  }
-  uint16_t q = day;
-  uint16_t m = month;
-  uint16_t k = year % 100;
-  uint16_t j = year / 100;
-  uint16_t h = (q + ((13 * (m + 1)) / 5) + k + (k / 4) + (j / 4) - (2 * j)) % 7;
-  // Zeller returns: 0=Sat, 1=Sun, 2=Mon, ...
-  // Convert to: 0=Sun, 1=Mon, ..., 6=Sat
-  return (h + 6) % 7;
+  int32_t days = daysFromCivil(year, month, day);
+  return days >= -4 ? (days + 4) % 7 : (days + 5) % 7 + 6;
 }
 
-// Get Nth Sunday of a month (n=1 for first, n=-1 for last)
-uint8_t getNthSunday(uint16_t year, uint8_t month, int8_t n) {
-  uint8_t daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-  
-  // Check for leap year
-  if ((year % 4 == 0 && year % 100 != 0) || (year % 400 == 0)) {
-    daysInMonth[2] = 29;
-  }
-  
+// Nth weekday (0=Sunday) of a month (n=1 for first, n=-1 for last)
+uint8_t getNthWeekday(uint16_t year, uint8_t month, uint8_t weekday, int8_t n) {
   if (n > 0) {
-    // Find the Nth Sunday: first check day 1, then add offset
+    // Find the first one from day 1's weekday, then add weeks
     uint8_t dow = getDayOfWeek(year, month, 1);
-    uint8_t firstSunday = 1 + ((7 - dow) % 7);
-    return firstSunday + ((n - 1) * 7);
+    uint8_t first = 1 + (7 + weekday - dow) % 7;
+    return first + ((n - 1) * 7);
   } else if (n == -1) {
-    // Find last Sunday
-    uint8_t lastDay = daysInMonth[month];
+    // Find the last one, backwards from the last day
+    uint8_t lastDay = getDaysInMonth(year, month);
     uint8_t dow = getDayOfWeek(year, month, lastDay);
-    return lastDay - dow;
+    return lastDay - (7 + dow - weekday) % 7;
   }
   
   return 1;
 }
 
-// DST for USA/Canada: 2nd Sunday in March to 1st Sunday in November
-bool isDSTActive_USA_Canada(uint16_t year, uint8_t month, uint8_t day) {
-  // March: DST from 2nd Sunday onward
-  if (month == 3) {
-    uint8_t secondSunday = getNthSunday(year, 3, 2);
-    return day >= secondSunday;
-  }
-  
-  // April-October: DST active
-  if (month > 3 && month < 11) {
-    return true;
+// Get Nth Sunday of a month (n=1 for first, n=-1 for last)
+uint8_t getNthSunday(uint16_t year, uint8_t month, int8_t n) {
+  return getNthWeekday(year, month, 0, n);
+}
+
+// Add offsetMinutes to a date and time of day, carrying across day, month and year boundaries
+void addMinutes(uint16_t& year, uint8_t& month, uint8_t& day,
+                uint8_t& hour, uint8_t& minute, int16_t offsetMinutes) {
+  int16_t minutes = (int16_t)hour * 60 + minute + offsetMinutes;
+  int8_t dayShift = 0;
+  while (minutes < 0) { minutes += 1440; dayShift--; }
+  while (minutes >= 1440) { minutes -= 1440; dayShift++; }
+  hour = minutes / 60;
+  minute = minutes % 60;
+  if (dayShift != 0) {
+    civilFromDays(daysFromCivil(year, month, day) + dayShift, year, month, day);
   }
-  
-  // November: DST until 1st Sunday (not including 1st Sunday)
-  if (month == 11) {
-    uint8_t firstSunday = getNthSunday(year, 11, 1);
-    return day < firstSunday;
+}
+
+// Day of year, 0-based (January 1 = 0)
+uint16_t getDayOfYear(uint16_t year, uint8_t month, uint8_t day) {
+  // Days before the 1st of each month in a non-leap year
+  static const uint16_t daysBeforeMonth[] = {0, 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+  return daysBeforeMonth[month] + day - 1 + (month > 2 && isLeapYear(year));
+}
+
+// Seconds since 00:00:00 on January 1 of the same year
+uint32_t getSecondsOfYear(uint16_t year, uint8_t month, uint8_t day,
+                          uint8_t hour, uint8_t minute, uint8_t second) {
+  return (uint32_t)getDayOfYear(year, month, day) * 86400UL +
+         (uint32_t)hour * 3600UL + (uint16_t)minute * 60 + second;
+}
+
+// Local wall-clock switch time (minutes after midnight) on a day of the year to
+// UTC seconds of the year. offsetMinutes is the UTC offset in force just before the switch.
+static uint32_t localSwitchToUTC(uint16_t dayOfYear, uint16_t localMinutes, int16_t offsetMinutes) {
+  int32_t t = (int32_t)dayOfYear * 86400L + ((int32_t)localMinutes - offsetMinutes) * 60L;
+  return t < 0 ? 0 : (uint32_t)t;
+}
+
+// Switch instant in UTC seconds of the year. The switch time is in the clock the
+// descriptor names; wallOffsetMinutes is the offset in force just before the switch.
+static uint32_t switchToUTC(const DSTSwitch& sw, uint16_t dayOfYear,
+                            int16_t stdOffsetMinutes, int16_t wallOffsetMinutes) {
+  int16_t offset = sw.timeBase == DST_AT_UTC ? 0
+                 : sw.timeBase == DST_AT_STANDARD ? stdOffsetMinutes : wallOffsetMinutes;
+  return localSwitchToUTC(dayOfYear, sw.minutes, offset);
+}
+
+// Day of year (0-based) a switch falls on
+uint16_t getDSTSwitchDay(const DSTSwitch& sw, uint16_t year) {
+  return getDayOfYear(year, sw.month, getNthWeekday(year, sw.month, sw.weekday, sw.week));
+}
+
+// Date-level DST state: from the start day up to the day before the end day
+bool isDSTActiveOnDate(const DSTRule& rule, uint16_t year, uint8_t month, uint8_t day) {
+  uint16_t doy = getDayOfYear(year, month, day);
+  uint16_t startDay = getDSTSwitchDay(rule.start, year);
+  uint16_t endDay = getDSTSwitchDay(rule.end, year);
+  // Southern hemisphere: daylight through the new year
+  return startDay < endDay ? (doy >= startDay && doy < endDay)
+                           : (doy >= startDay || doy < endDay);
+}
+
+// DST transition instants for one rule and year (UTC seconds of the year)
+bool getDSTTransitions(uint8_t ruleId, uint16_t year, int16_t stdOffsetMinutes,
+                       uint32_t& start, uint32_t& end) {
+  // Transition days come from the compile-time table (dst_table.cpp)
+  DSTRule rule;
+  uint16_t startDay, endDay;
+  if (!getDSTRule(ruleId, rule) || !getDSTTransitionDays(ruleId, year, startDay, endDay)) {
+    return false;
   }
-  
-  // December-February: standard time
-  return false;
+
+  // Standard time until the start switch, daylight time until the end switch
+  start = switchToUTC(rule.start, startDay, stdOffsetMinutes, stdOffsetMinutes);
+  end = switchToUTC(rule.end, endDay, stdOffsetMinutes, stdOffsetMinutes + rule.saveMinutes);
+  return true;
+}
+
+// Built-in rules evaluated at run time from their descriptors, bypassing the table
+static bool isDSTActiveForRule(uint8_t ruleId, uint16_t year, uint8_t month, uint8_t day) {
+  DSTRule rule;
+  return getDSTRule(ruleId, rule) && isDSTActiveOnDate(rule, year, month, day);
+}
+
+bool isDSTActive_USA_Canada(uint16_t year, uint8_t month, uint8_t day) {
+  return isDSTActiveForRule(DST_RULE_USA_CANADA, year, month, day);
 }
 
-// DST for UK/EU: Last Sunday in March to Last Sunday in October
 bool isDSTActive_UK(uint16_t year, uint8_t month, uint8_t day) {
-  // March: DST from last Sunday onward
-  if (month == 3) {
-    uint8_t lastSunday = getNthSunday(year, 3, -1);
-    return day >= lastSunday;
-  }
-  
-  // April-September: DST active
-  if (month > 3 && month < 10) {
-    return true;
-  }
-  
-  // October: DST until last Sunday (not including last Sunday)
-  if (month == 10) {
-    uint8_t lastSunday = getNthSunday(year, 10, -1);
-    return day < lastSunday;
-  }
-  
-  // November-February: standard time
-  return false;
+  return isDSTActiveForRule(DST_RULE_UK_EU, year, month, day);
 }
 
-// DST for Australia (Sydney/Melbourne): 1st Sunday in October to 1st Sunday in April
 bool isDSTActive_Australia(uint16_t year, uint8_t month, uint8_t day) {
-  // October: DST from 1st Sunday onward
-  if (month == 10) {
-    uint8_t firstSunday = getNthSunday(year, 10, 1);
-    return day >= firstSunday;
-  }
-  
-  // November-March: DST active
-  if (month > 10 || month < 4) {
-    return true;
-  }
-  
-  // April: DST until 1st Sunday (not including 1st Sunday)
-  if (month == 4) {
-    uint8_t firstSunday = getNthSunday(year, 4, 1);
-    return day < firstSunday;
-  }
-  
-  return false;
+  return isDSTActiveForRule(DST_RULE_AUSTRALIA, year, month, day);
 }
 
-// DST for New Zealand: Last Sunday in September to 1st Sunday in April
 bool isDSTActive_NewZealand(uint16_t year, uint8_t month, uint8_t day) {
-  // September: DST from last Sunday onward
-  if (month == 9) {
-    uint8_t lastSunday = getNthSunday(year, 9, -1);
-    return day >= lastSunday;
-  }
-  
-  // October-March: DST active
-  if (month > 9 || month < 4) {
-    return true;
-  }
-  
-  // April: DST until 1st Sunday (not including 1st Sunday)
-  if (month == 4) {
-    uint8_t firstSunday = getNthSunday(year, 4, 1);
-    return day < firstSunday;
-  }
-  
-  return false;
+  return isDSTActiveForRule(DST_RULE_NEW_ZEALAND, year, month, day);
 }
 
-// DST for Brazil: 3rd Sunday in October to 3rd Sunday in February
 bool isDSTActive_Brazil(uint16_t year, uint8_t month, uint8_t day) {
-  // October: DST from 3rd Sunday onward
-  if (month == 10) {
-    uint8_t thirdSunday = getNthSunday(year, 10, 3);
-    return day >= thirdSunday;
-  }
-  
-  // November-January: DST active
-  if (month > 10 && month < 2) {
-    return true;
-  }
-  
-  // February: DST until 3rd Sunday (not including 3rd Sunday)
-  if (month == 2) {
-    uint8_t thirdSunday = getNthSunday(year, 2, 3);
-    return day < thirdSunday;
-  }
-  
-  return false;
+  return isDSTActiveForRule(DST_RULE_BRAZIL, year, month, day);
 }
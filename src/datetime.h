@@ -8,15 +8,87 @@
 // Convert 24-hour time (0-23) to 12-hour (1-12) format
 uint8_t format12Hour(uint8_t hour24);
 
+// Gregorian leap year
+bool isLeapYear(uint16_t year);
+
+// Number of days in a month (1-12)
+uint8_t getDaysInMonth(uint16_t year, uint8_t month);
+
+// Epoch-day core: days since 1970-01-01 and back. Pure integer math with no
+// month tables or loops; valid for years 1-9999.
+int32_t daysFromCivil(uint16_t year, uint8_t month, uint8_t day);
+void civilFromDays(int32_t days, uint16_t& year, uint8_t& month, uint8_t& day);
+
+// Add offsetMinutes (e.g. a UTC offset) to a date and time of day,
+// carrying across day, month and year boundaries
+void addMinutes(uint16_t& year, uint8_t& month, uint8_t& day,
+                uint8_t& hour, uint8_t& minute, int16_t offsetMinutes);
+
 // Calculate day of week (0=Sunday, 1=Monday, ..., 6=Saturday)
-// Uses Zeller's congruence algorithm
+// Derived from the epoch-day core
 uint8_t getDayOfWeek(uint16_t year, uint8_t month, uint8_t day);
 
+// Day of month of the Nth weekday (0=Sunday) in a month (n=1 for first, n=-1 for last)
+uint8_t getNthWeekday(uint16_t year, uint8_t month, uint8_t weekday, int8_t n);
+
 // Get Nth Sunday of a month (n=1 for first, n=-1 for last)
 uint8_t getNthSunday(uint16_t year, uint8_t month, int8_t n);
 
-// DST algorithms for various regions
-// All take year, month, day and return true if DST is active
+// Day of year, 0-based (January 1 = 0)
+uint16_t getDayOfYear(uint16_t year, uint8_t month, uint8_t day);
+
+// Seconds since 00:00:00 on January 1 of the same year
+uint32_t getSecondsOfYear(uint16_t year, uint8_t month, uint8_t day,
+                          uint8_t hour, uint8_t minute, uint8_t second);
+
+// DST Rule Type Definitions (index into DST_RULES, dst_table.h)
+#define DST_RULE_NONE              0
+#define DST_RULE_USA_CANADA        1
+#define DST_RULE_UK_EU             2
+#define DST_RULE_AUSTRALIA         3
+#define DST_RULE_NEW_ZEALAND       4
+#define DST_RULE_BRAZIL            5
+#define DST_RULE_COUNT             5  // Rules with DST
+
+// Clock a DST switch time is given in (DSTSwitch::timeBase)
+#define DST_AT_WALL     0  // Local time in force just before the switch
+#define DST_AT_STANDARD 1  // Local standard time
+#define DST_AT_UTC      2
+
+// One DST switch: the Nth (or last) weekday of a month, at a time of day
+struct DSTSwitch {
+  uint8_t month;     // 1-12
+  int8_t week;       // 1-4 for the Nth weekday of the month, -1 for the last
+  uint8_t weekday;   // 0=Sunday
+  uint8_t timeBase;  // DST_AT_*
+  uint16_t minutes;  // Minutes after midnight, in timeBase
+};
+
+// A DST rule: daylight time from start until end, saveMinutes ahead of standard.
+// In the southern hemisphere end falls earlier in the year than start.
+struct DSTRule {
+  DSTSwitch start;
+  DSTSwitch end;
+  uint8_t saveMinutes;
+};
+
+// Day of year (0-based) a switch falls on
+uint16_t getDSTSwitchDay(const DSTSwitch& sw, uint16_t year);
+
+// Date-level DST state of a rule: true from the start day until the day before
+// the end day (the switch time itself is left to getDSTTransitions)
+bool isDSTActiveOnDate(const DSTRule& rule, uint16_t year, uint8_t month, uint8_t day);
+
+// DST transition instants for one rule (DST_RULE_*) and year, as UTC seconds of
+// that year (see getSecondsOfYear). Each switch happens at the time in the rule's
+// descriptor, e.g. USA/Canada 02:00 wall time, UK/EU 01:00 UTC. Returns false
+// if the rule has no DST. stdOffsetMinutes is the zone's standard UTC offset
+// (e.g. -300 for USA Eastern).
+bool getDSTTransitions(uint8_t rule, uint16_t year, int16_t stdOffsetMinutes,
+                       uint32_t& start, uint32_t& end);
+
+// Date-level DST state of the built-in rules, computed at run time from their
+// descriptors (the firmware uses getDSTTransitions; these serve tests and benchmarks)
 
 // USA/Canada: 2nd Sunday in March to 1st Sunday in November
 bool isDSTActive_USA_Canada(uint16_t year, uint8_t month, uint8_t day);
@@ -0,0 +1,89 @@
+#include "dst_table.h"
+
+#include <string.h>
+
+#ifndef __AVR__
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define memcpy_P memcpy
+#endif
+
+struct DSTTableEntry {
+  uint16_t startDay;  // Day of year (0-based) of the standard -> daylight switch
+  uint16_t endDay;    // Day of year (0-based) of the daylight -> standard switch
+};
+
+#define DST_TABLE_ENTRY(rule, year) {ctStartDay(rule, year), ctEndDay(rule, year)}
+#define DST_TABLE_ROW(year) { \
+  DST_TABLE_ENTRY(DST_RULE_USA_CANADA, year), \
+  DST_TABLE_ENTRY(DST_RULE_UK_EU, year), \
+  DST_TABLE_ENTRY(DST_RULE_AUSTRALIA, year), \
+  DST_TABLE_ENTRY(DST_RULE_NEW_ZEALAND, year), \
+  DST_TABLE_ENTRY(DST_RULE_BRAZIL, year)}
+
+// Every value is a constant expression: evaluated by the compiler, stored in flash
+static const DSTTableEntry dstTable[DST_TABLE_YEARS][DST_TABLE_RULES] PROGMEM = {
+  DST_TABLE_ROW(2026), DST_TABLE_ROW(2027), DST_TABLE_ROW(2028), DST_TABLE_ROW(2029),
+  DST_TABLE_ROW(2030), DST_TABLE_ROW(2031), DST_TABLE_ROW(2032), DST_TABLE_ROW(2033),
+  DST_TABLE_ROW(2034), DST_TABLE_ROW(2035),
+};
+static_assert(sizeof(dstTable) / sizeof(dstTable[0]) == DST_TABLE_YEARS,
+              "one DST_TABLE_ROW per year in DST_TABLE_FIRST_YEAR..DST_TABLE_LAST_YEAR");
+
+// ============================================================================
+// BUILD-TIME CHECKS
+// The generator must reproduce the transition dates the runtime algorithms give
+// (documented in TIMEZONE_DST.md); test_dst.cpp compares every table day against
+// the runtime kernel (isDSTActive_*).
+// ============================================================================
+
+// Weekday core: known dates
+static_assert(ctDayOfWeek(1970, 1, 1) == 4, "1970-01-01 was a Thursday");
+static_assert(ctDayOfWeek(2026, 3, 8) == 0, "2026-03-08 is a Sunday");
+static_assert(ctDayOfYear(2028, 12, 31) == 365, "2028 is a leap year");
+
+// USA/Canada: 2026 Mar 8 / Nov 1, 2027 Mar 14 / Nov 7, 2028 Mar 12 / Nov 5
+static_assert(ctNthSunday(2026, 3, 2) == 8 && ctNthSunday(2026, 11, 1) == 1, "USA 2026");
+static_assert(ctNthSunday(2027, 3, 2) == 14 && ctNthSunday(2027, 11, 1) == 7, "USA 2027");
+static_assert(ctNthSunday(2028, 3, 2) == 12 && ctNthSunday(2028, 11, 1) == 5, "USA 2028");
+static_assert(ctStartDay(DST_RULE_USA_CANADA, 2026) == 66, "USA 2026 start = day 66 (Mar 8)");
+static_assert(ctEndDay(DST_RULE_USA_CANADA, 2026) == 304, "USA 2026 end = day 304 (Nov 1)");
+
+// UK/EU: 2026 Mar 29 / Oct 25, 2027 Mar 28 / Oct 31, 2028 Mar 26 / Oct 29
+static_assert(ctNthSunday(2026, 3, -1) == 29 && ctNthSunday(2026, 10, -1) == 25, "UK 2026");
+static_assert(ctNthSunday(2027, 3, -1) == 28 && ctNthSunday(2027, 10, -1) == 31, "UK 2027");
+static_assert(ctNthSunday(2028, 3, -1) == 26 && ctNthSunday(2028, 10, -1) == 29, "UK 2028");
+static_assert(ctStartDay(DST_RULE_UK_EU, 2026) == 87, "UK 2026 start = day 87 (Mar 29)");
+static_assert(ctEndDay(DST_RULE_UK_EU, 2026) == 297, "UK 2026 end = day 297 (Oct 25)");
+
+// Southern hemisphere 2026: Australia Oct 4 / Apr 5, New Zealand Sep 27 / Apr 5, Brazil Oct 18 / Feb 15
+static_assert(ctNthSunday(2026, 10, 1) == 4 && ctNthSunday(2026, 4, 1) == 5, "Australia 2026");
+static_assert(ctNthSunday(2026, 9, -1) == 27, "New Zealand 2026");
+static_assert(ctNthSunday(2026, 10, 3) == 18 && ctNthSunday(2026, 2, 3) == 15, "Brazil 2026");
+
+// Weekdays other than Sunday (no built-in rule uses one yet)
+static_assert(ctNthWeekday(2026, 3, 1, 2) == 9, "2nd Monday of March 2026 is the 9th");
+static_assert(ctNthWeekday(2026, 10, 6, -1) == 31, "last Saturday of October 2026 is the 31st");
+
+bool getDSTRule(uint8_t rule, DSTRule& out) {
+  if (rule == DST_RULE_NONE || rule > DST_RULE_COUNT) return false;
+  memcpy_P(&out, &DST_RULES[rule - 1], sizeof(out));
+  return true;
+}
+
+bool getDSTTransitionDays(uint8_t rule, uint16_t year, uint16_t& startDay, uint16_t& endDay) {
+  if (rule == DST_RULE_NONE || rule > DST_TABLE_RULES) return false;
+
+  if (year >= DST_TABLE_FIRST_YEAR && year <= DST_TABLE_LAST_YEAR) {
+    const DSTTableEntry* entry = &dstTable[year - DST_TABLE_FIRST_YEAR][rule - 1];
+    startDay = pgm_read_word(&entry->startDay);
+    endDay = pgm_read_word(&entry->endDay);
+    return true;
+  }
+
+  // Outside the table: same rule, computed at run time
+  DSTRule r;
+  getDSTRule(rule, r);
+  startDay = getDSTSwitchDay(r.start, year);
+  endDay = getDSTSwitchDay(r.end, year);
+  return true;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <stdint.h>
+#include "datetime.h"
+
+// DST rule descriptors and the compile-time DST transition table.
+// DST_RULES describes every rule as data (datetime.h: DSTRule); one kernel in
+// datetime.cpp evaluates them, so a new rule is a table row, not new code.
+// For every DST rule and every year in DST_TABLE_FIRST_YEAR..DST_TABLE_LAST_YEAR,
+// the start and end day of year (0-based) are computed by constexpr functions at
+// build time and stored in flash. On the AVR the lookup is two flash reads instead
+// of weekday searches with 32-bit divisions; years outside the table fall back to
+// the runtime kernel.
+
+#ifndef PROGMEM
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#endif
+#endif
+
+#define DST_TABLE_FIRST_YEAR 2026
+#define DST_TABLE_LAST_YEAR  2035
+#define DST_TABLE_YEARS      (DST_TABLE_LAST_YEAR - DST_TABLE_FIRST_YEAR + 1)
+#define DST_TABLE_RULES      DST_RULE_COUNT
+
+// Indexed by rule - 1. Each switch: month, week (-1 = last), weekday (0 = Sunday),
+// clock (DST_AT_*), minutes after midnight; then the daylight saving in minutes.
+// Stored in flash: constexpr reads at build time, getDSTRule() at run time.
+constexpr DSTRule DST_RULES[DST_RULE_COUNT] PROGMEM = {
+  // DST_RULE_USA_CANADA: 2nd Sunday March 02:00 - 1st Sunday November 02:00 (wall time)
+  {{3, 2, 0, DST_AT_WALL, 120}, {11, 1, 0, DST_AT_WALL, 120}, 60},
+  // DST_RULE_UK_EU: last Sunday March - last Sunday October, 01:00 UTC
+  {{3, -1, 0, DST_AT_UTC, 60}, {10, -1, 0, DST_AT_UTC, 60}, 60},
+  // DST_RULE_AUSTRALIA: 1st Sunday October 02:00 standard - 1st Sunday April 03:00 daylight
+  {{10, 1, 0, DST_AT_WALL, 120}, {4, 1, 0, DST_AT_WALL, 180}, 60},
+  // DST_RULE_NEW_ZEALAND: last Sunday September 02:00 standard - 1st Sunday April 03:00 daylight
+  {{9, -1, 0, DST_AT_WALL, 120}, {4, 1, 0, DST_AT_WALL, 180}, 60},
+  // DST_RULE_BRAZIL: 3rd Sunday October - 3rd Sunday February, 00:00 (wall time)
+  {{10, 3, 0, DST_AT_WALL, 0}, {2, 3, 0, DST_AT_WALL, 0}, 60},
+};
+
+// ============================================================================
+// CONSTEXPR GENERATOR (C++11: single-expression functions)
+// Mirrors daysFromCivil / getNthWeekday / getDayOfYear in datetime.cpp
+// ============================================================================
+
+constexpr bool ctIsLeapYear(uint16_t year) {
+  return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+}
+
+constexpr uint8_t ctDaysInMonth(uint16_t year, uint8_t month) {
+  return month == 2 ? (ctIsLeapYear(year) ? 29 : 28)
+       : (month == 4 || month == 6 || month == 9 || month == 11) ? 30 : 31;
+}
+
+// daysFromCivil with the March-based year already applied
+constexpr int32_t ctDaysFromShiftedCivil(uint16_t y, uint8_t month, uint8_t day) {
+  return (int32_t)(y / 400) * 146097L +
+         (int32_t)(y % 400) * 365 + (y % 400) / 4 - (y % 400) / 100 +
+         (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1 - 719468L;
+}
+
+constexpr int32_t ctDaysFromCivil(uint16_t year, uint8_t month, uint8_t day) {
+  return ctDaysFromShiftedCivil(year - (month <= 2), month, day);
+}
+
+// 0=Sunday; only valid from 1970 on, which the table range guarantees
+constexpr uint8_t ctDayOfWeek(uint16_t year, uint8_t month, uint8_t day) {
+  return (ctDaysFromCivil(year, month, day) + 4) % 7;
+}
+
+constexpr uint8_t ctNthWeekday(uint16_t year, uint8_t month, uint8_t weekday, int8_t n) {
+  return n > 0 ? 1 + (7 + weekday - ctDayOfWeek(year, month, 1)) % 7 + (n - 1) * 7
+       : ctDaysInMonth(year, month) -
+         (7 + ctDayOfWeek(year, month, ctDaysInMonth(year, month)) - weekday) % 7;
+}
+
+constexpr uint8_t ctNthSunday(uint16_t year, uint8_t month, int8_t n) {
+  return ctNthWeekday(year, month, 0, n);
+}
+
+constexpr uint16_t ctDayOfYear(uint16_t year, uint8_t month, uint8_t day) {
+  return ctDaysFromCivil(year, month, day) - ctDaysFromCivil(year, 1, 1);
+}
+
+constexpr uint16_t ctSwitchDay(const DSTSwitch& sw, uint16_t year) {
+  return ctDayOfYear(year, sw.month, ctNthWeekday(year, sw.month, sw.weekday, sw.week));
+}
+
+constexpr uint16_t ctStartDay(uint8_t rule, uint16_t year) {
+  return ctSwitchDay(DST_RULES[rule - 1].start, year);
+}
+
+constexpr uint16_t ctEndDay(uint8_t rule, uint16_t year) {
+  return ctSwitchDay(DST_RULES[rule - 1].end, year);
+}
+
+// Copy a rule's descriptor out of flash. Returns false for DST_RULE_NONE (or an
+// unknown rule).
+bool getDSTRule(uint8_t rule, DSTRule& out);
+
+// Start and end day of year (0-based) for a DST rule and year: flash table inside
+// the table range, the runtime kernel outside it. Returns false for DST_RULE_NONE.
+bool getDSTTransitionDays(uint8_t rule, uint16_t year, uint16_t& startDay, uint16_t& endDay);
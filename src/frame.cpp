@@ -0,0 +1,83 @@
+#include "frame.h"
+#include <string.h>
+#include "crc16.h"
+
+#define FRAME_RX_LEN     1
+#define FRAME_RX_BODY    2
+#define FRAME_RX_CRC_HI  3
+#define FRAME_RX_CRC_LO  4
+#define FRAME_RX_DISCARD 5  // After a bad LEN or CRC: frame size unknown, drop bytes until a gap
+
+void frameReset(FrameReceiver& rx) {
+  rx.state = FRAME_RX_IDLE;
+  rx.len = 0;
+  rx.pos = 0;
+  rx.crc = 0;
+  rx.lastByteMs = 0;
+}
+
+bool frameActive(FrameReceiver& rx, uint32_t nowMs) {
+  // A stalled frame lost bytes (or a discard ended)
+  if (rx.state != FRAME_RX_IDLE && nowMs - rx.lastByteMs > FRAME_TIMEOUT_MS) {
+    frameReset(rx);
+  }
+  return rx.state != FRAME_RX_IDLE;
+}
+
+uint8_t frameFeed(FrameReceiver& rx, uint8_t byte, uint32_t nowMs) {
+  frameActive(rx, nowMs);  // Start over if the previous frame stalled
+  rx.lastByteMs = nowMs;
+
+  switch (rx.state) {
+    case FRAME_RX_IDLE:
+      if (byte == FRAME_SYNC) rx.state = FRAME_RX_LEN;
+      return FRAME_PENDING;
+
+    case FRAME_RX_LEN:
+      if (byte == 0 || byte > FRAME_MAX_BODY) {
+        rx.state = FRAME_RX_DISCARD;
+        return FRAME_BAD_LENGTH;
+      }
+      rx.len = byte;
+      rx.pos = 0;
+      rx.state = FRAME_RX_BODY;
+      return FRAME_PENDING;
+
+    case FRAME_RX_BODY:
+      rx.body[rx.pos++] = byte;
+      if (rx.pos == rx.len) rx.state = FRAME_RX_CRC_HI;
+      return FRAME_PENDING;
+
+    case FRAME_RX_DISCARD:
+      return FRAME_PENDING;
+
+    case FRAME_RX_CRC_HI:
+      rx.crc = (uint16_t)byte << 8;
+      rx.state = FRAME_RX_CRC_LO;
+      return FRAME_PENDING;
+
+    default: {
+      rx.crc |= byte;
+      uint16_t crc = crc16(&rx.len, 1);
+      crc = crc16(rx.body, rx.len, crc);
+      if (crc != rx.crc) {
+        // LEN itself may be corrupt, so the frame's last bytes may still be on
+        // their way: swallow them rather than let them land in the text line
+        rx.state = FRAME_RX_DISCARD;
+        return FRAME_BAD_CRC;
+      }
+      rx.state = FRAME_RX_IDLE;
+      return FRAME_READY;
+    }
+  }
+}
+
+uint8_t frameEncode(uint8_t* out, const uint8_t* body, uint8_t len) {
+  out[0] = FRAME_SYNC;
+  out[1] = len;
+  memcpy(out + 2, body, len);
+  uint16_t crc = crc16(out + 1, len + 1);
+  out[len + 2] = crc >> 8;
+  out[len + 3] = crc & 0xFF;
+  return len + FRAME_OVERHEAD;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdint.h>
+
+// Binary frames for the serial protocol, accepted alongside the text commands
+// once a client has seen "bin" in the H (handshake) reply.
+//
+//   SYNC  LEN  BODY[LEN]  CRC_HI  CRC_LO
+//
+// BODY is an opcode plus fixed-width fields (command.h: decodeCommand). The CRC
+// is crc16() (CRC-16/CCITT-FALSE) over LEN and BODY. SYNC (0xA5) is not a
+// printable character, so a byte at the start of a line tells frames from text.
+// No hardware dependencies: the receiver is fed one byte at a time.
+
+#define FRAME_SYNC       0xA5
+#define FRAME_MAX_BODY   24   // Largest body: A (sync all) is 18 bytes
+#define FRAME_OVERHEAD   4    // SYNC, LEN, CRC16
+#define FRAME_MAX_SIZE   (FRAME_MAX_BODY + FRAME_OVERHEAD)
+#define FRAME_TIMEOUT_MS 100  // A frame stalled this long between bytes is dropped
+
+// Reply frames: BODY = opcode | FRAME_REPLY, status, payload
+#define FRAME_REPLY 0x80
+
+// Reply status: PARSE_OK / PARSE_UNKNOWN / PARSE_BAD_ARGS (command.h), or
+#define FRAME_STATUS_BAD_CRC    3
+#define FRAME_STATUS_BAD_LENGTH 4
+
+// frameFeed() results
+#define FRAME_PENDING    0  // Byte consumed, frame not complete yet
+#define FRAME_READY      1  // body/len hold a frame with a valid CRC
+#define FRAME_BAD_CRC    2  // Complete frame, CRC mismatch: dropped, and since LEN may be
+                            // wrong, later bytes are discarded until the line is quiet for
+                            // FRAME_TIMEOUT_MS
+#define FRAME_BAD_LENGTH 3  // LEN is 0 or larger than FRAME_MAX_BODY: the rest of the
+                            // frame is discarded until the line is quiet for FRAME_TIMEOUT_MS
+
+struct FrameReceiver {
+  uint8_t state;                // Internal; FRAME_RX_IDLE when not inside a frame
+  uint8_t len;
+  uint8_t pos;
+  uint16_t crc;
+  uint32_t lastByteMs;
+  uint8_t body[FRAME_MAX_BODY];
+};
+
+#define FRAME_RX_IDLE 0
+
+// Reset to idle (also the initial state)
+void frameReset(FrameReceiver& rx);
+
+// True while a frame is being received (or a bad one discarded). A frame whose
+// bytes stopped arriving for FRAME_TIMEOUT_MS is dropped first, so the next
+// byte is free to start a text line.
+bool frameActive(FrameReceiver& rx, uint32_t nowMs);
+
+// Feed one byte. When idle, only FRAME_SYNC starts a frame (anything else is
+// ignored). nowMs is used to drop a frame whose bytes stopped arriving.
+uint8_t frameFeed(FrameReceiver& rx, uint8_t byte, uint32_t nowMs);
+
+// Write a complete frame for body[0..len) into out (FRAME_OVERHEAD + len bytes).
+// Returns the frame size.
+uint8_t frameEncode(uint8_t* out, const uint8_t* body, uint8_t len);
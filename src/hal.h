@@ -0,0 +1,38 @@
+#pragma once
+
+// Hardware access for main.cpp: the one place the firmware pulls in the Arduino
+// core, the AVR sleep and power-reduction headers and the RTC, display and
+// EEPROM libraries. With HAL_NATIVE (the test_native environment) the same
+// names resolve to the mocks in test/mocks, so the unchanged firmware
+// translation unit builds on the host and the native simulator
+// (test/mocks/Simulator.h) can run setup()/loop() in virtual time.
+//
+// Timestamps in the firmware are uint32_t, which is what unsigned long is on the
+// AVR, so the 32-bit millis()/micros() wrap also happens in the simulator.
+
+#ifdef HAL_NATIVE
+
+#include "MockArduino.h"
+#include "MockSerial.h"
+#include "MockEEPROM.h"
+#include "MockRTC.h"
+#include "MockTM1637.h"
+#include "MockPower.h"
+
+#define Serial MockSerial
+#define EEPROM MockEEPROM
+#define Wire   MockWire
+typedef MockDateTime DateTime;
+typedef MockRTC RTC_DS3231;
+typedef MockTM1637 TM1637Display;
+
+#else
+
+#include <Wire.h>
+#include <EEPROM.h>
+#include <RTClib.h>
+#include <TM1637Display.h>
+#include <avr/sleep.h>
+#include <avr/power.h>
+
+#endif
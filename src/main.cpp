@@ -1,16 +1,43 @@
-#include <Wire.h>
-#include <EEPROM.h>
-#include <RTClib.h>
-#include <TM1637Display.h>
+#include "hal.h"
 #include "datetime.h"
+#include "dst_table.h"
+#include "settings.h"
+#include "command.h"
+#include "frame.h"
+#include "txqueue.h"
 
 #define CLK_PIN 3
 #define DIO_PIN 4
+#define SQW_PIN 2  // DS3231 SQW/INT output (open drain), must be an external interrupt pin
 
-// EEPROM Address Map (simplified, no DST tables)
+// Tick source: 1 = DS3231 1 Hz square wave on SQW_PIN wakes loop() once per second,
+// 0 = legacy polling with delay(500). Override with -DTICK_FROM_SQW=0 in build_flags.
+#ifndef TICK_FROM_SQW
+#define TICK_FROM_SQW 1
+#endif
+
+// If no SQW edge arrives for this long (pin not wired, RTC INTCN set), fall back to a timed tick
+#define SQW_TIMEOUT_MS 1500
+
+// I2C bus clock for the DS3231: 400000 (fast mode, default) or 100000 (standard mode)
+#ifndef I2C_CLOCK_HZ
+#define I2C_CLOCK_HZ 400000UL
+#endif
+
+// DS3231 registers written directly (RTClib has no aging offset API)
+#define DS3231_ADDRESS   0x68
+#define DS3231_REG_AGING 0x10
+
+// Idle sleep between ticks (SQW mode): the CPU stops until the next interrupt
+#ifndef SLEEP_BETWEEN_TICKS
+#define SLEEP_BETWEEN_TICKS 1
+#endif
+
+// Legacy EEPROM Address Map (single bytes, firmware before the settings ring).
+// Only read once, to migrate into the first settings record; see settings.h.
 #define ADDR_BRIGHTNESS        0x00  // 1 byte, 0-7
 #define ADDR_FORMAT_12H        0x01  // 1 byte, 0=24h, 1=12h
-#define ADDR_TZ_ID             0x02  // 1 byte, timezone ID (0-20)
+#define ADDR_TZ_ID             0x02  // 1 byte, timezone ID
 #define ADDR_DST_RULES_VERSION 0x03  // 1 byte, version of DST rules
 // Scheduled Brightness Dimming
 #define ADDR_SCHEDULE_ENABLED  0x04  // 1 byte, 0=off, 1=on
@@ -22,128 +49,499 @@
 #define ADDR_BRIGHT_BRIGHTNESS 0x0A  // 1 byte, 0-7 (brightness during bright period)
 
 // DST Rules Version for firmware compatibility checks
-#define DST_RULES_VERSION 2
+#define DST_RULES_VERSION 3
+
+// Serial link: boot always comes up at SERIAL_BAUD_DEFAULT. After U switches to a
+// faster rate, the host must get a P through within BAUD_VERIFY_TIMEOUT_MS or the
+// firmware falls back to the default rate.
+#define SERIAL_BAUD_DEFAULT    9600UL
+#define BAUD_VERIFY_TIMEOUT_MS 2000
+
+// Settings changes are committed once no further change arrived for this long,
+// so a full dashboard sync costs one ring record instead of one write per command
+#define SETTINGS_COMMIT_DELAY_MS 2000
 
 TM1637Display display(CLK_PIN, DIO_PIN);
 RTC_DS3231 rtc;
 
 // Timezone definitions with DST rules encoded in ID
+// The table lives in flash (PROGMEM): read fields with the tz*() helpers below
+#define TZ_NAME_LEN 19  // Longest name ("Australia Adelaide") + NUL
+
 struct Timezone {
   uint8_t id;
-  int8_t utc_offset_hours;
-  const char* name;
-  uint8_t dst_rule;  // 0=None, 1=USA/Canada, 2=UK/EU
+  int16_t utc_offset_minutes;  // Standard time
+  char name[TZ_NAME_LEN];
+  uint8_t dst_rule;  // DST_RULE_* (datetime.h), described in DST_RULES (dst_table.h)
 };
 
-// DST Rule Type Definitions
-#define DST_RULE_NONE              0
-#define DST_RULE_USA_CANADA        1
-#define DST_RULE_UK_EU             2
-#define DST_RULE_AUSTRALIA         3
-#define DST_RULE_NEW_ZEALAND       4
-#define DST_RULE_BRAZIL            5
-
-const Timezone timezones[] = {
-  {0,   0, "UTC",                 DST_RULE_NONE},
-  {1,  -5, "USA Eastern",         DST_RULE_USA_CANADA},
-  {2,  -6, "USA Central",         DST_RULE_USA_CANADA},
-  {3,  -7, "USA Mountain",        DST_RULE_USA_CANADA},
-  {4,  -8, "USA Pacific",         DST_RULE_USA_CANADA},
-  {5,  -3, "Canada Atlantic",     DST_RULE_USA_CANADA},
-  {6,  -5, "Canada Eastern",      DST_RULE_USA_CANADA},
-  {7,  -6, "Canada Central",      DST_RULE_USA_CANADA},
-  {8,  -7, "Canada Mountain",     DST_RULE_NONE},
-  {9,  -8, "Canada Pacific",      DST_RULE_USA_CANADA},
-  {10,  0, "UK London",           DST_RULE_UK_EU},
-  {11, -7, "Arizona",             DST_RULE_NONE},
-  {12,-10, "Hawaii",              DST_RULE_NONE},
-  {13, -9, "Samoa",               DST_RULE_NONE},
-  {14,  1, "EU Central",          DST_RULE_UK_EU},
-  {15,  2, "EU Eastern",          DST_RULE_UK_EU},
-  {16,-10, "Australia Sydney",    DST_RULE_AUSTRALIA},
-  {17, -9, "Australia Adelaide",  DST_RULE_AUSTRALIA},
-  {18, -8, "Australia Perth",     DST_RULE_NONE},
-  {19, 12, "New Zealand",         DST_RULE_NEW_ZEALAND},
-  {20, -3, "Brazil Sao Paulo",    DST_RULE_BRAZIL}
+const Timezone timezones[] PROGMEM = {
+  {0,     0, "UTC",                 DST_RULE_NONE},
+  {1,  -300, "USA Eastern",         DST_RULE_USA_CANADA},
+  {2,  -360, "USA Central",         DST_RULE_USA_CANADA},
+  {3,  -420, "USA Mountain",        DST_RULE_USA_CANADA},
+  {4,  -480, "USA Pacific",         DST_RULE_USA_CANADA},
+  {5,  -240, "Canada Atlantic",     DST_RULE_USA_CANADA},
+  {6,  -300, "Canada Eastern",      DST_RULE_USA_CANADA},
+  {7,  -360, "Canada Central",      DST_RULE_USA_CANADA},
+  {8,  -420, "Canada Mountain",     DST_RULE_NONE},
+  {9,  -480, "Canada Pacific",      DST_RULE_USA_CANADA},
+  {10,    0, "UK London",           DST_RULE_UK_EU},
+  {11, -420, "Arizona",             DST_RULE_NONE},
+  {12, -600, "Hawaii",              DST_RULE_NONE},
+  {13, -540, "Samoa",               DST_RULE_NONE},
+  {14,   60, "EU Central",          DST_RULE_UK_EU},
+  {15,  120, "EU Eastern",          DST_RULE_UK_EU},
+  {16,  600, "Australia Sydney",    DST_RULE_AUSTRALIA},
+  {17,  570, "Australia Adelaide",  DST_RULE_AUSTRALIA},
+  {18,  480, "Australia Perth",     DST_RULE_NONE},
+  {19,  720, "New Zealand",         DST_RULE_NEW_ZEALAND},
+  {20, -180, "Brazil Sao Paulo",    DST_RULE_BRAZIL},
+  {21,  330, "India",               DST_RULE_NONE},
+  {22,  345, "Nepal",               DST_RULE_NONE}
 };
 const uint8_t NUM_TIMEZONES = sizeof(timezones) / sizeof(timezones[0]);
+static_assert(NUM_TIMEZONES - 1 == CMD_TZ_ID_MAX, "Z command range (command.h) must match timezones[]");
 
 // Runtime state
-DateTime lastDateCheck;
+int32_t lastLocalDay = 0;  // Local calendar day (days since 1970-01-01) seen by the last tick
 bool dstActive = false;
-uint8_t tzId = 0; // Default UTC
 // (DateTime functions are now in datetime.h / datetime.cpp)
 
-// Helper: Get timezone UTC offset in hours
-int8_t getTimezoneOffset(uint8_t id) {
+// Persisted settings, loaded once at boot; the hot path only ever reads this copy
+Settings settings;
+SettingsRing settingsRing;
+bool settingsDirty = false;
+uint32_t settingsDirtyMillis = 0;
+
+// Record that a persisted field changed; the commit is deferred (see SETTINGS_COMMIT_DELAY_MS)
+void markSettingsDirty() {
+  settingsDirty = true;
+  settingsDirtyMillis = millis();
+}
+
+// Performance counters (QC, reset by RC). Kept cheap: increments on the hot
+// path, micros() only once per tick and around handleSerial() calls with input.
+struct PerfCounters {
+  uint32_t resetMillis;    // millis() at the last reset
+  uint32_t loops;          // loop() passes
+  uint32_t ticks;          // Clock ticks processed
+  uint32_t tickLateMaxUs;  // SQW edge to tick processing: jitter of the 1 Hz loop period
+  uint32_t tickWorkMaxUs;  // Longest tick (RTC read, schedule, display)
+  uint32_t serialMaxUs;    // Slowest handleSerial() with input or output pending
+  uint32_t i2cTransfers;   // DS3231 bus transfers (a read is two: pointer, data)
+  uint16_t eepromWrites;   // EEPROM bytes actually written
+  uint16_t rxOverflows;    // Lines dropped with ERR:RX overflow
+  uint16_t dayChanges;     // Local calendar days started (daily housekeeping runs)
+};
+PerfCounters perf;
+
+// Serial output is queued (txqueue.h) and moved to the UART from loop(), so
+// printing a reply does not wait for the line unless both buffers are full
+TxQueue txQueue;
+uint32_t txWaitUs = 0;     // Time the current handleSerial() waited on TX
+uint32_t txWaitMaxUs = 0;  // Worst case so far (QV)
+
+// Move queued bytes into the hardware TX buffer as far as it has room; never blocks
+void drainTx() {
+  uint8_t chunk[16];
+  int room = Serial.availableForWrite();
+  while (room > 0 && !txQueueEmpty(txQueue)) {
+    uint8_t n = txQueueTake(txQueue, chunk, room < (int)sizeof(chunk) ? room : sizeof(chunk));
+    Serial.write(chunk, n);
+    room -= n;
+  }
+}
+
+class QueuedSerial : public Print {
+public:
+  using Print::write;
+  size_t write(uint8_t b) {
+    // Straight into the hardware buffer while it has room and nothing is queued ahead
+    if (txQueueEmpty(txQueue) && Serial.availableForWrite() > 0) return Serial.write(b);
+    if (!txQueuePut(txQueue, b)) {
+      // Both buffers full: the only place output still waits for the UART
+      uint32_t start = micros();
+      while (!txQueuePut(txQueue, b)) drainTx();
+      txWaitUs += micros() - start;
+    }
+    return 1;
+  }
+};
+QueuedSerial serialOut;
+
+// Command replies go through `reply` and DBG lines through `dbg`: the serial
+// output, or a sink that drops everything (output level below ack/debug, or a
+// binary frame running the same handlers)
+class NullPrint : public Print {
+public:
+  size_t write(uint8_t) { return 1; }
+};
+NullPrint nullPrint;
+Print* reply = &serialOut;
+Print* dbg = &serialOut;
+
+// Binary frame receiver (frame.h); text lines and frames share the serial port
+FrameReceiver frameRx;
+
+// Baud negotiation state (U / P)
+uint32_t serialBaud = SERIAL_BAUD_DEFAULT;
+uint32_t pendingBaud = 0;           // Rate to switch to once the U reply is out
+bool baudVerifying = false;         // Switched, waiting for the host's P
+uint32_t baudSwitchMillis = 0;
+
+// Helper: Index of timezone `id` in timezones[], or NUM_TIMEZONES if unknown
+uint8_t findTimezone(uint8_t id) {
   for (uint8_t i = 0; i < NUM_TIMEZONES; i++) {
-    if (timezones[i].id == id) return timezones[i].utc_offset_hours;
+    if (pgm_read_byte(&timezones[i].id) == id) return i;
   }
-  return 0;  // Default UTC
+  return NUM_TIMEZONES;
 }
 
-// Scheduled Brightness State
-bool scheduleEnabled = false;
-uint8_t dimHour = 22;
-uint8_t dimMinute = 0;
-uint8_t brightHour = 7;
-uint8_t brightMinute = 0;
-uint8_t dimBrightness = 1;
-uint8_t brightBrightness = 5;
-bool currentlyDim = false;
+// Helper: Get timezone standard UTC offset in minutes
+int16_t getTimezoneOffset(uint8_t id) {
+  uint8_t i = findTimezone(id);
+  if (i == NUM_TIMEZONES) return 0;  // Default UTC
+  return (int16_t)pgm_read_word(&timezones[i].utc_offset_minutes);
+}
+
+// Helper: Get timezone DST rule (DST_RULE_NONE if unknown)
+uint8_t getTimezoneDSTRule(uint8_t id) {
+  uint8_t i = findTimezone(id);
+  if (i == NUM_TIMEZONES) return DST_RULE_NONE;
+  return pgm_read_byte(&timezones[i].dst_rule);
+}
+
+// Helper: Print timezone name straight from flash
+void printTimezoneName(Print& out, uint8_t id) {
+  uint8_t i = findTimezone(id);
+  if (i == NUM_TIMEZONES) {
+    out.print(F("Unknown"));
+    return;
+  }
+  out.print(reinterpret_cast<const __FlashStringHelper*>(timezones[i].name));
+}
+
+// Helper: Free SRAM between the heap (or .bss end) and the stack
+int freeMemory() {
+#ifdef __AVR__
+  extern char __heap_start, *__brkval;
+  char top;
+  return &top - (__brkval == 0 ? &__heap_start : __brkval);
+#else
+  return -1;  // Not meaningful off-target
+#endif
+}
+
+// 1 Hz tick state (written by the SQW interrupt)
+volatile bool tickPending = false;
+volatile uint32_t tickMicros = 0;  // micros() at the most recent SQW falling edge (or RTC write)
+uint32_t lastTickMillis = 0;
+
+// Per-tick clock snapshot: the RTC is read once per tick and every consumer
+// (display, schedule, date and DST logic) works from this copy
+struct ClockSnapshot {
+  DateTime utc;          // Raw RTC reading (RTC stores UTC)
+  uint16_t localYear;    // Local date, may differ from the UTC date near midnight
+  uint8_t localMonth;
+  uint8_t localDay;
+  uint8_t localHour;     // 0-23, timezone offset and DST applied
+  uint8_t localMinute;   // 0-59
+  uint16_t minuteOfDay;  // localHour * 60 + localMinute
+  bool dst;              // DST state used to derive the local fields
+};
+ClockSnapshot clockNow;
+
+// DST transition cache for one timezone and UTC year. Rebuilt when the timezone
+// or date is set (Z/D) and when the year rolls over; every other tick only
+// compares the current instant against nextTransition.
+#define DST_NO_TRANSITION 0xFFFFFFFFUL
 
-// Main DST check: dispatches to the appropriate algorithm based on timezone ID
+struct DSTCache {
+  uint8_t tzId;
+  uint16_t year;
+  bool hasDST;              // false for zones without DST
+  uint32_t start;           // Standard -> daylight, UTC seconds of the year
+  uint32_t end;             // Daylight -> standard, UTC seconds of the year
+  uint32_t nextTransition;  // Next instant dstActive flips; DST_NO_TRANSITION if none this year
+  int16_t stdOffsetMinutes;
+  uint8_t saveMinutes;      // Daylight saving of the rule
+  int16_t offsetMinutes;    // Effective UTC offset: standard + DST
+};
+DSTCache dstCache = {0xFF, 0, false, 0, 0, 0, 0, 0, 0};
+
+// UTC seconds of the year for the snapshot reading
+uint32_t snapshotSecondsOfYear() {
+  const DateTime& now = clockNow.utc;
+  return getSecondsOfYear(now.year(), now.month(), now.day(), now.hour(), now.minute(), now.second());
+}
+
+// Set dstActive, the effective offset and the next transition for instant t
+void applyDSTState(uint32_t t) {
+  if (!dstCache.hasDST) {
+    dstActive = false;
+    dstCache.nextTransition = DST_NO_TRANSITION;
+  } else if (dstCache.start < dstCache.end) {
+    // Northern hemisphere: daylight between start and end
+    dstActive = t >= dstCache.start && t < dstCache.end;
+    dstCache.nextTransition = t < dstCache.start ? dstCache.start
+                            : (t < dstCache.end ? dstCache.end : DST_NO_TRANSITION);
+  } else {
+    // Southern hemisphere: daylight from start through the new year until end
+    dstActive = t < dstCache.end || t >= dstCache.start;
+    dstCache.nextTransition = t < dstCache.end ? dstCache.end
+                            : (t < dstCache.start ? dstCache.start : DST_NO_TRANSITION);
+  }
+  dstCache.offsetMinutes = dstCache.stdOffsetMinutes + (dstActive ? dstCache.saveMinutes : 0);
+}
+
+// Main DST check: rebuild the transition cache for the current timezone and year
 void checkAndApplyDST() {
-  DateTime now = rtc.now();
+  const DateTime& now = clockNow.utc;
   
-  // Get the DST rule type for the current timezone
-  uint8_t dstRule = DST_RULE_NONE;
-  for (uint8_t i = 0; i < NUM_TIMEZONES; i++) {
-    if (timezones[i].id == tzId) {
-      dstRule = timezones[i].dst_rule;
-      break;
-    }
+  // Get the DST rule for the current timezone
+  uint8_t dstRule = getTimezoneDSTRule(settings.tzId);
+  DSTRule rule;
+  
+  dstCache.tzId = settings.tzId;
+  dstCache.year = now.year();
+  dstCache.stdOffsetMinutes = getTimezoneOffset(settings.tzId);
+  dstCache.saveMinutes = getDSTRule(dstRule, rule) ? rule.saveMinutes : 0;
+  dstCache.hasDST = getDSTTransitions(dstRule, now.year(), dstCache.stdOffsetMinutes,
+                                      dstCache.start, dstCache.end);
+  applyDSTState(snapshotSecondsOfYear());
+}
+
+// Per-tick DST check: one comparison unless the year or timezone changed
+void updateDST() {
+  if (clockNow.utc.year() != dstCache.year || settings.tzId != dstCache.tzId) {
+    checkAndApplyDST();
+    return;
+  }
+  if (dstCache.nextTransition != DST_NO_TRANSITION) {
+    uint32_t t = snapshotSecondsOfYear();
+    if (t >= dstCache.nextTransition) applyDSTState(t);
   }
+}
+
+// Recompute the local fields of the snapshot from clockNow.utc (no I2C traffic)
+void deriveLocalTime() {
+  // Calculate local time from UTC + cached effective offset (timezone + DST),
+  // carrying into the date when the offset crosses midnight
+  const DateTime& utc = clockNow.utc;
+  clockNow.localYear = utc.year();
+  clockNow.localMonth = utc.month();
+  clockNow.localDay = utc.day();
+  clockNow.localHour = utc.hour();
+  clockNow.localMinute = utc.minute();
+  addMinutes(clockNow.localYear, clockNow.localMonth, clockNow.localDay,
+             clockNow.localHour, clockNow.localMinute, dstCache.offsetMinutes);
   
-  // Apply the appropriate DST algorithm
-  switch (dstRule) {
-    case DST_RULE_USA_CANADA:
-      dstActive = isDSTActive_USA_Canada(now.year(), now.month(), now.day());
-      break;
-    case DST_RULE_UK_EU:
-      dstActive = isDSTActive_UK(now.year(), now.month(), now.day());
-      break;
-    case DST_RULE_AUSTRALIA:
-      dstActive = isDSTActive_Australia(now.year(), now.month(), now.day());
-      break;
-    case DST_RULE_NEW_ZEALAND:
-      dstActive = isDSTActive_NewZealand(now.year(), now.month(), now.day());
-      break;
-    case DST_RULE_BRAZIL:
-      dstActive = isDSTActive_Brazil(now.year(), now.month(), now.day());
-      break;
-    default:
-      dstActive = false;
-      break;
+  clockNow.minuteOfDay = clockNow.localHour * 60 + clockNow.localMinute;
+  clockNow.dst = dstActive;
+}
+
+// Read the RTC once (single 7-byte I2C burst) and refresh the snapshot
+void readClock() {
+  clockNow.utc = rtc.now();
+  perf.i2cTransfers += 2;
+  updateDST();
+  deriveLocalTime();
+}
+
+// Write the RTC and keep the snapshot in step without reading it back
+void writeClock(const DateTime& utc) {
+  rtc.adjust(utc);
+  perf.i2cTransfers++;
+  // Writing the seconds register restarts the DS3231's 1 Hz countdown: the new
+  // second starts now and the next SQW edge follows one second later
+  noInterrupts();
+  tickMicros = micros();
+  interrupts();
+  clockNow.utc = utc;
+  if (dstCache.hasDST) {
+    dstCache.nextTransition = 0;  // The date may have jumped: re-evaluate against the cache
+  }
+  updateDST();
+  deriveLocalTime();
+}
+
+// Trim the DS3231 crystal: +1 slows the RTC by about 0.1 ppm at 25 °C. The RTC
+// applies it at its next temperature conversion (within 64 s).
+void writeAgingOffset(int8_t offset) {
+  Wire.beginTransmission(DS3231_ADDRESS);
+  Wire.write(DS3231_REG_AGING);
+  Wire.write((uint8_t)offset);
+  Wire.endTransmission();
+  perf.i2cTransfers++;
+}
+
+// The last precise set (W) stops being a drift baseline once the clock is set another
+// way or its rate changes
+void clearDriftBaseline() {
+  if (settings.lastSetUtc != 0) {
+    settings.lastSetUtc = 0;
+    markSettingsDirty();
+  }
+}
+
+// Set the RTC from a local date and time in the current timezone. The offset is
+// the one in effect at the new instant, so a jump across a DST transition costs
+// a second RTC write with the corrected offset.
+void writeLocalClock(uint16_t y, uint8_t mo, uint8_t d, uint8_t h, uint8_t mi, uint8_t s) {
+  clearDriftBaseline();
+  int16_t offset = dstCache.offsetMinutes;
+  for (uint8_t pass = 0; pass < 2; pass++) {
+    uint16_t year = y;
+    uint8_t month = mo, day = d, hour = h, minute = mi;
+    addMinutes(year, month, day, hour, minute, -offset);
+    writeClock(DateTime(year, month, day, hour, minute, s));
+    if (dstCache.offsetMinutes == offset) break;
+    offset = dstCache.offsetMinutes;
+  }
+}
+
+// Minute rollover latency: time from the RTC second boundary (SQW edge) to the
+// display write that shows the new minute. Reported by the QT command.
+uint8_t lastShownMinute = 0xFF;
+uint32_t rolloverLatencyLastUs = 0;
+uint32_t rolloverLatencyMaxUs = 0;
+uint16_t rolloverCount = 0;
+
+// SQW falling edge marks the DS3231 seconds register update
+void onSqwTick() {
+  tickMicros = micros();
+  tickPending = true;
+}
+
+// Precise time set (J / W): the host timestamps J probes against its own clock,
+// keeps the one with the shortest round trip, and schedules the RTC write for
+// the instant a UTC second starts, as a delay after that probe's arrival here
+#define TIME_SET_SPIN_US 2000  // Wait out the last stretch in place rather than in loop()
+// The DS3231 latches the seconds register (and restarts its countdown) on the
+// acknowledge of the seconds byte: address, register and seconds bytes into the write
+#define RTC_WRITE_LEAD_US (27UL * 1000000UL / I2C_CLOCK_HZ)
+
+uint32_t probeMicros[TIME_PROBE_SLOTS];  // micros() when each J slot was last probed
+uint8_t probeValid = 0;                   // Bit per slot
+uint8_t lastProbeSlot = 0;                // For the binary J reply
+
+struct PendingTimeSet {
+  bool armed;
+  bool report;        // Text reply once written (not for binary frames)
+  uint32_t atMicros;  // When the second starts
+  uint32_t utc;       // Unix time of that second
+};
+PendingTimeSet timeSet = {false, false, 0, 0};
+
+// RTC time at micros() value `at`: UTC seconds, and µs into that second
+// from the last SQW edge or RTC write
+uint32_t rtcTimeAt(uint32_t at, uint32_t& phaseUs) {
+  noInterrupts();
+  uint32_t edge = tickMicros;
+  bool pending = tickPending;
+  interrupts();
+  // clockNow is read on the tick after an edge; a pending edge is one second on
+  uint32_t secs = clockNow.utc.unixtime() + (pending ? 1 : 0);
+  int32_t elapsed = (int32_t)(at - edge);
+  if (elapsed < 0) {
+    // The edge arrived between `at` and now
+    secs--;
+    elapsed += 1000000L;
+  }
+  phaseUs = (uint32_t)elapsed % 1000000UL;
+  return secs + (uint32_t)elapsed / 1000000UL;
+}
+
+// Display framebuffer: the last frame and brightness pushed to the TM1637.
+// The bit-banged transfer only runs when a segment byte or the brightness changed.
+struct DisplayFramebuffer {
+  uint8_t segments[4];
+  uint8_t brightness;
+  bool valid;                  // false until the first transfer
+  bool brightnessDirty;        // TM1637Display applies brightness on the next setSegments()
+  uint32_t framesRendered;     // frames built by updateDisplay()
+  uint32_t framesTransmitted;  // frames actually sent to the TM1637
+};
+DisplayFramebuffer framebuffer = {{0, 0, 0, 0}, 0xFF, false, false, 0, 0};
+
+void setDisplayBrightness(uint8_t brightness) {
+  if (brightness == framebuffer.brightness) return;
+  framebuffer.brightness = brightness;
+  framebuffer.brightnessDirty = true;
+  display.setBrightness(brightness);
+}
+
+// Push a frame, skipping the transfer when nothing differs from the last one sent
+void renderFrame(const uint8_t segments[4]) {
+  framebuffer.framesRendered++;
+  if (framebuffer.valid && !framebuffer.brightnessDirty &&
+      memcmp(framebuffer.segments, segments, 4) == 0) {
+    return;
+  }
+  display.setSegments(segments, 4, 0);
+  memcpy(framebuffer.segments, segments, 4);
+  framebuffer.valid = true;
+  framebuffer.brightnessDirty = false;
+  framebuffer.framesTransmitted++;
+}
+
+// Scheduled Brightness State
+bool currentlyDim = false;
+bool displayBlanked = false;  // Dim period with night blanking (K1): frames are all off
+
+uint8_t eepromReadByte(uint16_t addr) {
+  return EEPROM.read(addr);
+}
+
+void eepromUpdateByte(uint16_t addr, uint8_t value) {
+  if (EEPROM.read(addr) != value) perf.eepromWrites++;
+  EEPROM.update(addr, value);  // Skips the erase/write cycle for unchanged bytes
+}
+
+// Load the newest settings record; on first boot after an upgrade, migrate the
+// legacy single-byte layout into the ring
+void loadSettings() {
+  if (!settingsLoad(settings, settingsRing, eepromReadByte)) {
+    settingsDefaults(settings);
+    settings.brightness = EEPROM.read(ADDR_BRIGHTNESS);
+    settings.format12h = EEPROM.read(ADDR_FORMAT_12H);
+    settings.tzId = EEPROM.read(ADDR_TZ_ID);
+    settings.dstRulesVersion = EEPROM.read(ADDR_DST_RULES_VERSION);
+    settings.scheduleEnabled = EEPROM.read(ADDR_SCHEDULE_ENABLED);
+    settings.dimHour = EEPROM.read(ADDR_DIM_HOUR);
+    settings.dimMinute = EEPROM.read(ADDR_DIM_MINUTE);
+    settings.brightHour = EEPROM.read(ADDR_BRIGHT_HOUR);
+    settings.brightMinute = EEPROM.read(ADDR_BRIGHT_MINUTE);
+    settings.dimBrightness = EEPROM.read(ADDR_DIM_BRIGHTNESS);
+    settings.brightBrightness = EEPROM.read(ADDR_BRIGHT_BRIGHTNESS);
+    settingsSanitize(settings, NUM_TIMEZONES - 1);
+    settingsCommit(settings, settingsRing, eepromUpdateByte);
+    dbg->println(F("DBG:Settings migrated"));
+  }
+  // Validate and use defaults if corrupted
+  settingsSanitize(settings, NUM_TIMEZONES - 1);
+}
+
+// Write the current settings as one ring record now (also flushes any pending change)
+void commitSettings() {
+  settingsDirty = false;
+  settingsCommit(settings, settingsRing, eepromUpdateByte);
+}
+
+// Write one ring record once the burst of setting changes has settled
+void commitSettingsIfIdle() {
+  if (settingsDirty && millis() - settingsDirtyMillis >= SETTINGS_COMMIT_DELAY_MS) {
+    commitSettings();
   }
 }
 
 void updateDisplay() {
-  DateTime now = rtc.now();  // RTC stores UTC
+  // Local time comes from the per-tick snapshot
+  uint8_t h = clockNow.localHour;
+  uint8_t m = clockNow.localMinute;
   
-  // Calculate local time from UTC + timezone offset + DST
-  int8_t offset = getTimezoneOffset(tzId);
-  if (dstActive) offset += 1;
-  int16_t localHour = (int16_t)now.hour() + offset;
-  
-  // Handle day wrap-around
-  if (localHour < 0) localHour += 24;
-  if (localHour >= 24) localHour -= 24;
-  
-  uint8_t h = (uint8_t)localHour;
-  uint8_t m = now.minute();
-  
-  uint8_t format = EEPROM.read(ADDR_FORMAT_12H);
+  uint8_t format = settings.format12h;
   
   // 7-segment encoding (0-9)
   const uint8_t digitToSegment[] = {
@@ -176,408 +574,866 @@ void updateDisplay() {
   segments[1] = digitToSegment[digit1] | 0x80;  // Always show colon (bit 7 of digit 1)
   segments[2] = digitToSegment[digit2];
   segments[3] = digitToSegment[digit3];
+  if (displayBlanked) memset(segments, 0, sizeof(segments));  // Brightness 0 is still lit
   
-  // Display all segments
-  display.setSegments(segments, 4, 0);
+  // Display all segments (no-op if unchanged)
+  renderFrame(segments);
+
+  if (m != lastShownMinute) {
+    // Skip the first frame after boot, it is not a rollover
+    if (lastShownMinute != 0xFF) {
+      noInterrupts();
+      uint32_t edge = tickMicros;
+      interrupts();
+      uint32_t latency = micros() - edge;
+      rolloverLatencyLastUs = latency;
+      if (latency > rolloverLatencyMaxUs) rolloverLatencyMaxUs = latency;
+      rolloverCount++;
+    }
+    lastShownMinute = m;
+  }
 }
 
 
 
-// Auto-increment date if 24 hours have passed
-static unsigned long lastMillis = 0;
-void autoIncrementDate() {
-  unsigned long currentMillis = millis();
-  
-  // Check if ~24 hours (86400000ms) have elapsed
-  if (currentMillis - lastMillis >= 86400000UL) {
-    lastMillis = currentMillis;
-    
-    DateTime now = rtc.now();
-    
-    // Increment date by 1 day
-    // RTClib doesn't have a built-in increment, so we use adjust with nextDay logic
-    uint16_t day = now.day() + 1;
-    uint8_t month = now.month();
-    uint16_t year = now.year();
-    
-    // Simple day overflow (doesn't account for days per month, but good enough)
-    uint8_t daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-    
-    // Check for leap year
-    if ((year % 4 == 0 && year % 100 != 0) || (year % 400 == 0)) {
-      daysInMonth[2] = 29;
-    }
-    
-    if (day > daysInMonth[month]) {
-      day = 1;
-      month++;
-      if (month > 12) {
-        month = 1;
-        year++;
-      }
-    }
-    
-    rtc.adjust(DateTime(year, month, day, now.hour(), now.minute(), now.second()));
-    checkAndApplyDST();
-  }
+// Local calendar day of the snapshot, in days since 1970-01-01
+int32_t snapshotLocalDay() {
+  return daysFromCivil(clockNow.localYear, clockNow.localMonth, clockNow.localDay);
+}
+
+// Daily housekeeping, once per local calendar day. The DS3231 keeps its own
+// calendar, so the day change is read from the snapshot; the RTC is never written.
+void checkDayChange() {
+  int32_t today = snapshotLocalDay();
+  if (today == lastLocalDay) return;
+  lastLocalDay = today;
+  perf.dayChanges++;
+  checkAndApplyDST();  // Re-evaluate DST for the new day (transitions are also caught per tick)
 }
 
 // Check if current time is within dim period (handles midnight wrap-around)
-bool isInDimPeriod(uint8_t currentHour, uint8_t currentMinute) {
-  uint16_t currentMinutes = currentHour * 60 + currentMinute;
-  uint16_t dimMinutes = dimHour * 60 + dimMinute;
-  uint16_t brightMinutes = brightHour * 60 + brightMinute;
+bool isInDimPeriod(uint16_t currentMinutes) {
+  uint16_t dimMinutes = settings.dimHour * 60 + settings.dimMinute;
+  uint16_t brightMinutes = settings.brightHour * 60 + settings.brightMinute;
   
   if (dimMinutes < brightMinutes) {
-    // Normal case: dim period doesn't cross midnight (e.g., 22:00-07:00 next day)
-    // Current time is in dim period if it's >= dim OR < bright
-    return currentMinutes >= dimMinutes || currentMinutes < brightMinutes;
-  } else {
     // Dim period is during the day (e.g., 08:00-18:00)
     return currentMinutes >= dimMinutes && currentMinutes < brightMinutes;
+  } else {
+    // Dim period crosses midnight (e.g., 22:00-07:00 next day)
+    // Current time is in dim period if it's >= dim OR < bright
+    return currentMinutes >= dimMinutes || currentMinutes < brightMinutes;
   }
 }
 
 // Check schedule and apply brightness if needed
 void checkScheduledBrightness() {
-  if (!scheduleEnabled) {
+  if (!settings.scheduleEnabled) {
+    displayBlanked = false;
     return;
   }
   
-  // RTC stores UTC, calculate local time for schedule comparison
-  DateTime now = rtc.now();
-  int8_t offset = getTimezoneOffset(tzId);
-  if (dstActive) offset += 1;
-  int16_t localHour = (int16_t)now.hour() + offset;
-  if (localHour < 0) localHour += 24;
-  if (localHour >= 24) localHour -= 24;
-  
-  bool shouldBeDim = isInDimPeriod((uint8_t)localHour, now.minute());
+  // Same snapshot as the display, so both agree across a minute boundary
+  bool shouldBeDim = isInDimPeriod(clockNow.minuteOfDay);
+  displayBlanked = shouldBeDim && settings.nightBlank;
   
   // Only update if state changed (to avoid unnecessary writes)
   if (shouldBeDim != currentlyDim) {
     currentlyDim = shouldBeDim;
-    uint8_t newBrightness = shouldBeDim ? dimBrightness : brightBrightness;
-    display.setBrightness(newBrightness);
-    updateDisplay();
+    uint8_t newBrightness = shouldBeDim ? settings.dimBrightness : settings.brightBrightness;
+    setDisplayBrightness(newBrightness);  // Sent with the next updateDisplay() in loop()
   }
 }
 
-void handleSerial() {
+// Command handlers: called with arguments already parsed and range-checked (see command.h)
+void cmdTime(const Command& cmd) {
+  // T<hour>,<minute>,<second> - Browser sends LOCAL time, we store UTC in RTC
+  int16_t h = cmd.args[0], m = cmd.args[1], s = cmd.args[2];
+  // Keep the local date; the UTC date may be the day before or after it
+  readClock();
+  writeLocalClock(clockNow.localYear, clockNow.localMonth, clockNow.localDay, h, m, s);
+  updateDisplay();
+  reply->print(F("OK:T"));
+  reply->print(h); reply->print(':');
+  reply->print(m); reply->print(':');
+  reply->println(s);
+}
+
+void cmdDate(const Command& cmd) {
+  // D<month>,<day>,<year> - Update local date and recalculate DST
+  int16_t m = cmd.args[0], d = cmd.args[1], y = cmd.args[2];
+  // Keep the current local time of day on the new local date
+  readClock();
+  writeLocalClock(y, m, d, clockNow.localHour, clockNow.localMinute, clockNow.utc.second());
+  lastLocalDay = snapshotLocalDay();
+  checkAndApplyDST();  // Recalculate DST status with new date
+  updateDisplay();
+  reply->print(F("OK:D"));
+  reply->print(m); reply->print('/');
+  reply->print(d); reply->print('/');
+  reply->println(y);
+}
+
+void cmdFormat(const Command& cmd) {
+  // F<0|1> (0=24h, 1=12h)
+  int16_t f = cmd.args[0];
+  settings.format12h = f;
+  markSettingsDirty();
+  updateDisplay();
+  uint8_t stored = settings.format12h;
+  // Local time for debug output comes from the snapshot
+  const DateTime& now = clockNow.utc;
+  uint8_t localHour = clockNow.localHour;
+  uint8_t shownHour = (stored == 1) ? format12Hour(localHour) : localHour;
+  dbg->print(F("DBG:F requested="));
+  dbg->print(f);
+  dbg->print(F(" stored="));
+  dbg->print(stored);
+  dbg->print(F(" rtcHour24UTC="));
+  dbg->print(now.hour());
+  dbg->print(F(" localHour="));
+  dbg->print(localHour);
+  dbg->print(F(" shownHour="));
+  dbg->println(shownHour);
+  reply->print(F("OK:F"));
+  reply->println(stored);
+}
+
+void cmdTimezone(const Command& cmd) {
+  // Z<tz_id> (0-CMD_TZ_ID_MAX)
+  // Timezone ID selector with DST rule dispatch
+  uint8_t z = cmd.args[0];
+  settings.tzId = z;
+  
+  // Mark DST rules version
+  settings.dstRulesVersion = DST_RULES_VERSION;
+  markSettingsDirty();
+  
+  checkAndApplyDST();
+  
+  reply->print(F("OK:Z"));
+  reply->println(z);
+  dbg->print(F("DBG:TZ "));
+  printTimezoneName(*dbg, z);
+  dbg->print(F(" rule="));
+  dbg->println(getTimezoneDSTRule(z));
+}
+
+void cmdBrightness(const Command& cmd) {
+  // B<0-7> (brightness)
+  uint8_t b = cmd.args[0];
+  settings.brightness = b;
+  markSettingsDirty();
+  setDisplayBrightness(b);
+  updateDisplay();
+  reply->print(F("OK:B"));
+  reply->println(b);
+}
+
+void cmdSchedule(const Command& cmd) {
+  // S<0|1> - Enable (1) or disable (0) scheduled dimming
+  uint8_t s = cmd.args[0];
+  settings.scheduleEnabled = s;
+  markSettingsDirty();
+  reply->print(F("OK:S"));
+  reply->println(s);
+}
+
+void cmdNightBlank(const Command& cmd) {
+  // K<0|1> - Blank the display instead of dimming it in the scheduled dim period
+  settings.nightBlank = cmd.args[0];
+  markSettingsDirty();
+  checkScheduledBrightness();
+  updateDisplay();
+  reply->print(F("OK:K"));
+  reply->println(settings.nightBlank);
+}
+
+void cmdNightOrDay(const Command& cmd) {
+  // N<h>,<m>,<b> - Set night (dim) time and brightness
+  // Y<h>,<m>,<b> - Set day (bright) time and brightness
+  uint8_t h = cmd.args[0], m = cmd.args[1], b = cmd.args[2];
+  if (cmd.op == CMD_NIGHT) {
+    settings.dimHour = h;
+    settings.dimMinute = m;
+    settings.dimBrightness = b;
+    reply->print(F("OK:N"));
+  } else {
+    settings.brightHour = h;
+    settings.brightMinute = m;
+    settings.brightBrightness = b;
+    reply->print(F("OK:Y"));
+  }
+  markSettingsDirty();
+  currentlyDim = false;  // Force re-check on next cycle
+  reply->print(h); reply->print(':');
+  reply->print(m); reply->print(':');
+  reply->println(b);
+}
+
+// Schedule fields as reported by QS and A: enabled=1,dim=22:00:1,bright=07:00:5,blank=0
+void printSchedule() {
+  reply->print(F("enabled="));
+  reply->print(settings.scheduleEnabled ? 1 : 0);
+  reply->print(F(",dim="));
+  if (settings.dimHour < 10) reply->print('0');
+  reply->print(settings.dimHour);
+  reply->print(':');
+  if (settings.dimMinute < 10) reply->print('0');
+  reply->print(settings.dimMinute);
+  reply->print(':');
+  reply->print(settings.dimBrightness);
+  reply->print(F(",bright="));
+  if (settings.brightHour < 10) reply->print('0');
+  reply->print(settings.brightHour);
+  reply->print(':');
+  if (settings.brightMinute < 10) reply->print('0');
+  reply->print(settings.brightMinute);
+  reply->print(':');
+  reply->print(settings.brightBrightness);
+  reply->print(F(",blank="));
+  reply->print(settings.nightBlank);
+}
+
+void cmdQuerySchedule() {
+  // QS - Query schedule settings
+  reply->print(F("OK:QS "));
+  printSchedule();
+  reply->println();
+}
+
+void cmdQueryTick() {
+  // QT - Query tick source and minute rollover latency (microseconds)
+  reply->print(F("OK:QT mode="));
+  reply->print(TICK_FROM_SQW ? F("sqw") : F("poll"));
+  reply->print(F(",last="));
+  reply->print(rolloverLatencyLastUs);
+  reply->print(F(",max="));
+  reply->print(rolloverLatencyMaxUs);
+  reply->print(F(",n="));
+  reply->println(rolloverCount);
+}
+
+void cmdQueryDisplay() {
+  // QD - Query display framebuffer counters (frames built vs. sent to the TM1637)
+  reply->print(F("OK:QD rendered="));
+  reply->print(framebuffer.framesRendered);
+  reply->print(F(",sent="));
+  reply->println(framebuffer.framesTransmitted);
+}
+
+void cmdSyncAll(const Command& cmd) {
+  // A<m>,<d>,<y>,<h>,<mi>,<s>,<f>,<z>,<b>,<e>,<nh>,<nm>,<nb>,<yh>,<ym>,<yb>
+  // Full dashboard sync: every field is already validated, so apply them all and
+  // persist them as one settings record
+  const int16_t* a = cmd.args;
+  settings.format12h = a[SYNC_FORMAT];
+  settings.tzId = a[SYNC_TZ];
+  settings.dstRulesVersion = DST_RULES_VERSION;
+  settings.brightness = a[SYNC_BRIGHTNESS];
+  settings.scheduleEnabled = a[SYNC_SCHEDULE];
+  settings.dimHour = a[SYNC_DIM_HOUR];
+  settings.dimMinute = a[SYNC_DIM_MINUTE];
+  settings.dimBrightness = a[SYNC_DIM_LEVEL];
+  settings.brightHour = a[SYNC_BRIGHT_HOUR];
+  settings.brightMinute = a[SYNC_BRIGHT_MINUTE];
+  settings.brightBrightness = a[SYNC_BRIGHT_LEVEL];
+  commitSettings();
+  
+  // DST cache for the new timezone first, then the local date and time in it
+  checkAndApplyDST();
+  writeLocalClock(a[SYNC_YEAR], a[SYNC_MONTH], a[SYNC_DAY], a[SYNC_HOUR], a[SYNC_MINUTE], a[SYNC_SECOND]);
+  lastLocalDay = snapshotLocalDay();
+  
+  setDisplayBrightness(settings.brightness);
+  currentlyDim = false;  // Force re-check on next cycle
+  checkScheduledBrightness();
+  updateDisplay();
+  
+  // One consolidated acknowledgement with the applied state
+  reply->print(F("OK:A date="));
+  reply->print(clockNow.localMonth); reply->print('/');
+  reply->print(clockNow.localDay); reply->print('/');
+  reply->print(clockNow.localYear);
+  reply->print(F(",time="));
+  reply->print(clockNow.localHour); reply->print(':');
+  reply->print(clockNow.localMinute); reply->print(':');
+  reply->print(clockNow.utc.second());
+  reply->print(F(",dst="));
+  reply->print(dstActive ? 1 : 0);
+  reply->print(F(",f="));
+  reply->print(settings.format12h);
+  reply->print(F(",z="));
+  reply->print(settings.tzId);
+  reply->print(F(",b="));
+  reply->print(settings.brightness);
+  reply->print(',');
+  printSchedule();
+  reply->println();
+}
+
+void printProbe(uint8_t slot) {
+  uint32_t phase;
+  uint32_t secs = rtcTimeAt(probeMicros[slot], phase);
+  reply->print(F("OK:J"));
+  reply->print(slot);
+  reply->print(F(" utc="));
+  reply->print(secs);
+  reply->print(F(",us="));
+  reply->println(phase);
+}
+
+void cmdTimeProbe(const Command& cmd) {
+  // J<slot> - Timestamp the probe's arrival and reply with the RTC time at that instant
+  uint8_t slot = cmd.args[0];
+  probeMicros[slot] = micros();
+  probeValid |= 1 << slot;
+  lastProbeSlot = slot;
+  printProbe(slot);
+}
+
+void cmdTimeSetAt(const Command& cmd) {
+  // W<slot>,<ms>,<m>,<d>,<y>,<h>,<mi>,<s> - Write this UTC time <ms> after probe <slot> arrived
+  const int16_t* a = cmd.args;
+  uint8_t slot = a[TSET_SLOT];
+  if (!(probeValid & (1 << slot))) {
+    reply->println(F("ERR:W no probe"));
+    return;
+  }
+  uint32_t at = probeMicros[slot] + (uint32_t)a[TSET_DELAY_MS] * 1000UL;
+  if ((int32_t)(at - micros()) <= 0) {
+    reply->println(F("ERR:W late"));
+    return;
+  }
+  timeSet.armed = true;
+  timeSet.report = reply != &nullPrint;
+  timeSet.atMicros = at;
+  timeSet.utc = DateTime(a[TSET_YEAR], a[TSET_MONTH], a[TSET_DAY],
+                         a[TSET_HOUR], a[TSET_MINUTE], a[TSET_SECOND]).unixtime();
+  // Replies once written (serviceTimeSet)
+}
+
+// Called every loop() pass: write the RTC of a pending W at its instant
+void serviceTimeSet() {
+  if (!timeSet.armed) return;
+  uint32_t writeAt = timeSet.atMicros - RTC_WRITE_LEAD_US;
+  int32_t remaining = (int32_t)(writeAt - micros());
+  if (remaining > TIME_SET_SPIN_US) return;
+  if (remaining > 0) delayMicroseconds(remaining);
+  int32_t late = (int32_t)(micros() - writeAt);
+  timeSet.armed = false;
+
+  writeClock(DateTime(timeSet.utc));
+  settings.lastSetUtc = timeSet.utc;
+  markSettingsDirty();
+  lastLocalDay = snapshotLocalDay();
+  checkAndApplyDST();
+  updateDisplay();
+
+  if (timeSet.report) {
+    // How far the write missed its instant; the host measures the remaining offset with J
+    reply->print(F("OK:W utc="));
+    reply->print(timeSet.utc);
+    reply->print(F(",late="));
+    reply->println(late);
+  }
+}
+
+void cmdAging(const Command& cmd) {
+  // G<-128..127> - DS3231 aging offset, saved and restored at boot
+  settings.aging = cmd.args[0];
+  writeAgingOffset(settings.aging);
+  clearDriftBaseline();
+  markSettingsDirty();
+  reply->print(F("OK:G"));
+  reply->println(settings.aging);
+}
+
+void cmdQueryAging() {
+  // QG - Aging offset and the drift baseline (last W, unix time; 0 = none)
+  reply->print(F("OK:QG aging="));
+  reply->print(settings.aging);
+  reply->print(F(",set="));
+  reply->println(settings.lastSetUtc);
+}
+
+// Output level (V); stored inverted so records from before the field default to debug
+uint8_t verbosity() {
+  return VERBOSITY_DEBUG - settings.quiet;
+}
+
+// Default outputs for the current level; commands narrow `reply` while they run
+void applyVerbosity() {
+  reply = &serialOut;
+  dbg = verbosity() == VERBOSITY_DEBUG ? (Print*)&serialOut : &nullPrint;
+}
+
+void cmdVerbosity(const Command& cmd) {
+  // V<0-2> - silent / ack-only / debug
+  settings.quiet = VERBOSITY_DEBUG - cmd.args[0];
+  markSettingsDirty();
+  applyVerbosity();
+  reply->print(F("OK:V"));
+  reply->println(cmd.args[0]);
+}
+
+void cmdQueryVerbosity() {
+  // QV - Output level, TX queue high-water mark and longest wait on TX (µs)
+  reply->print(F("OK:QV level="));
+  reply->print(verbosity());
+  reply->print(F(",txpeak="));
+  reply->print(txQueue.peak);
+  reply->print(F(",txwait="));
+  reply->println(txWaitMaxUs);
+}
+
+void resetCounters() {
+  memset(&perf, 0, sizeof(perf));
+  perf.resetMillis = millis();
+}
+
+void cmdQueryCounters() {
+  // QC - Performance counters since boot or the last RC; durations in µs
+  reply->print(F("OK:QC up="));
+  reply->print((millis() - perf.resetMillis) / 1000);
+  reply->print(F(",loops="));
+  reply->print(perf.loops);
+  reply->print(F(",ticks="));
+  reply->print(perf.ticks);
+  reply->print(F(",late="));
+  reply->print(perf.tickLateMaxUs);
+  reply->print(F(",work="));
+  reply->print(perf.tickWorkMaxUs);
+  reply->print(F(",serial="));
+  reply->print(perf.serialMaxUs);
+  reply->print(F(",i2c="));
+  reply->print(perf.i2cTransfers);
+  reply->print(F(",eeprom="));
+  reply->print(perf.eepromWrites);
+  reply->print(F(",rxovf="));
+  reply->print(perf.rxOverflows);
+  reply->print(F(",days="));
+  reply->println(perf.dayChanges);
+}
+
+void cmdSetBaud(const Command& cmd) {
+  // U<baud/100> - Acknowledge at the current rate; the switch happens after the
+  // reply is sent (see applyPendingBaud)
+  pendingBaud = baudFromCode(cmd.args[0]);
+  reply->print(F("OK:U"));
+  reply->println(cmd.args[0]);
+}
+
+void cmdPing() {
+  // P - Link check; confirms a rate switched by U
+  baudVerifying = false;
+  reply->print(F("OK:P baud="));
+  reply->println(serialBaud);
+}
+
+// Reopen the UART at a new rate once everything queued at the old rate is out
+void setSerialBaud(uint32_t baud) {
+  while (!txQueueEmpty(txQueue)) drainTx();
+  Serial.flush();
+  Serial.end();
+  Serial.begin(baud);
+  serialBaud = baud;
+}
+
+// Switch to the rate requested by U (after its reply) and start the verify window
+void applyPendingBaud() {
+  if (pendingBaud == 0) return;
+  setSerialBaud(pendingBaud);
+  pendingBaud = 0;
+  baudVerifying = serialBaud != SERIAL_BAUD_DEFAULT;
+  baudSwitchMillis = millis();
+}
+
+// No P at the new rate in time: the host could not follow, go back to the default
+void checkBaudFallback() {
+  if (baudVerifying && millis() - baudSwitchMillis >= BAUD_VERIFY_TIMEOUT_MS) {
+    baudVerifying = false;
+    setSerialBaud(SERIAL_BAUD_DEFAULT);
+    dbg->println(F("DBG:Baud fallback 9600"));
+  }
+}
+
+// Reply for a known command with bad or out-of-range arguments
+void printCommandError(uint8_t op, const char* line) {
+  switch (op) {
+    case CMD_TIME:       reply->println(F("ERR:T expected h,m,s")); break;
+    case CMD_DATE:       reply->println(F("ERR:D expected m,d,y")); break;
+    case CMD_FORMAT:     reply->println(F("ERR:F expected 0 or 1")); break;
+    case CMD_TIMEZONE:
+      reply->print(F("ERR:Z expected 0.."));
+      reply->println(NUM_TIMEZONES - 1);
+      break;
+    case CMD_BRIGHTNESS: reply->println(F("ERR:B expected 0..7")); break;
+    case CMD_SCHEDULE:   reply->println(F("ERR:S expected 0 or 1")); break;
+    case CMD_NIGHT:      reply->println(F("ERR:N expected h,m,b")); break;
+    case CMD_DAY:        reply->println(F("ERR:Y expected h,m,b")); break;
+    case CMD_SYNC_ALL:   reply->println(F("ERR:A expected m,d,y,h,mi,s,f,z,b,e,nh,nm,nb,yh,ym,yb")); break;
+    case CMD_SET_BAUD:   reply->println(F("ERR:U expected 96,192,384,576,1152")); break;
+    case CMD_VERBOSITY:  reply->println(F("ERR:V expected 0..2")); break;
+    case CMD_TIME_PROBE: reply->println(F("ERR:J expected 0..7")); break;
+    case CMD_TIME_SET_AT: reply->println(F("ERR:W expected slot,ms,m,d,y,h,mi,s")); break;
+    case CMD_AGING:      reply->println(F("ERR:G expected -128..127")); break;
+    case CMD_NIGHT_BLANK: reply->println(F("ERR:K expected 0 or 1")); break;
+    default:
+      // Queries take no arguments: anything after the name is not a known command
+      reply->print(F("ERR:UNKNOWN "));
+      reply->println(line);
+      break;
+  }
+}
+
+// Run the handler of a parsed, range-checked command
+void runCommand(const Command& cmd) {
+  switch (cmd.op) {
+    case CMD_TIME:           cmdTime(cmd); break;
+    case CMD_DATE:           cmdDate(cmd); break;
+    case CMD_FORMAT:         cmdFormat(cmd); break;
+    case CMD_TIMEZONE:       cmdTimezone(cmd); break;
+    case CMD_BRIGHTNESS:     cmdBrightness(cmd); break;
+    case CMD_SCHEDULE:       cmdSchedule(cmd); break;
+    case CMD_NIGHT:
+    case CMD_DAY:            cmdNightOrDay(cmd); break;
+    case CMD_QUERY_FORMAT:
+      reply->print(F("OK:QF"));
+      reply->println(settings.format12h);
+      break;
+    case CMD_QUERY_SCHEDULE: cmdQuerySchedule(); break;
+    case CMD_QUERY_TICK:     cmdQueryTick(); break;
+    case CMD_QUERY_DISPLAY:  cmdQueryDisplay(); break;
+    case CMD_SYNC_ALL:       cmdSyncAll(cmd); break;
+    case CMD_HANDSHAKE:
+      // H - Protocol version and features: "bin" binary frames, "baud" U/P negotiation,
+      // "ts" J/W precise time set
+      reply->print(F("OK:H proto="));
+      reply->print(PROTOCOL_VERSION);
+      reply->println(F(",features=bin+baud+ts+blank"));
+      break;
+    case CMD_SET_BAUD:       cmdSetBaud(cmd); break;
+    case CMD_PING:           cmdPing(); break;
+    case CMD_VERBOSITY:      cmdVerbosity(cmd); break;
+    case CMD_QUERY_VERBOSITY: cmdQueryVerbosity(); break;
+    case CMD_QUERY_COUNTERS: cmdQueryCounters(); break;
+    case CMD_RESET_COUNTERS:
+      resetCounters();
+      reply->println(F("OK:RC"));
+      break;
+    case CMD_TIME_PROBE:     cmdTimeProbe(cmd); break;
+    case CMD_TIME_SET_AT:    cmdTimeSetAt(cmd); break;
+    case CMD_AGING:          cmdAging(cmd); break;
+    case CMD_QUERY_AGING:    cmdQueryAging(); break;
+    case CMD_NIGHT_BLANK:    cmdNightBlank(cmd); break;
+  }
+}
+
+// Parse one received line and run its handler
+void dispatchCommand(const char* line) {
+  Command cmd;
+  uint8_t result = parseCommand(line, cmd);
+  // Silent: only commands whose reply carries data answer
+  if (verbosity() == VERBOSITY_SILENT && !commandAlwaysReplies(cmd.op)) reply = &nullPrint;
+  if (result == PARSE_UNKNOWN) {
+    reply->print(F("ERR:UNKNOWN "));
+    reply->println(line);
+  } else if (result == PARSE_BAD_ARGS) {
+    printCommandError(cmd.op, line);
+  } else {
+    runCommand(cmd);
+  }
+  applyVerbosity();
+}
+
+// Big-endian fields for binary reply payloads
+uint8_t putU16(uint8_t* out, uint16_t v) {
+  out[0] = v >> 8;
+  out[1] = v & 0xFF;
+  return 2;
+}
+
+uint8_t putU32(uint8_t* out, uint32_t v) {
+  putU16(out, v >> 16);
+  return 2 + putU16(out + 2, v & 0xFFFF);
+}
+
+// Fixed-width reply payload of a binary command (the state the text reply prints).
+// Returns the payload size.
+uint8_t encodeReplyPayload(uint8_t op, uint8_t* out) {
+  uint8_t n = 0;
+  switch (op) {
+    case CMD_QUERY_FORMAT:
+      out[n++] = settings.format12h;
+      break;
+    case CMD_QUERY_SCHEDULE:
+      out[n++] = settings.scheduleEnabled;
+      out[n++] = settings.dimHour;
+      out[n++] = settings.dimMinute;
+      out[n++] = settings.dimBrightness;
+      out[n++] = settings.brightHour;
+      out[n++] = settings.brightMinute;
+      out[n++] = settings.brightBrightness;
+      out[n++] = settings.nightBlank;
+      break;
+    case CMD_QUERY_TICK:
+      out[n++] = TICK_FROM_SQW;
+      n += putU32(out + n, rolloverLatencyLastUs);
+      n += putU32(out + n, rolloverLatencyMaxUs);
+      n += putU16(out + n, rolloverCount);
+      break;
+    case CMD_QUERY_DISPLAY:
+      n += putU32(out + n, framebuffer.framesRendered);
+      n += putU32(out + n, framebuffer.framesTransmitted);
+      break;
+    case CMD_HANDSHAKE:
+      out[n++] = PROTOCOL_VERSION;
+      out[n++] = PROTOCOL_FEATURE_BINARY | PROTOCOL_FEATURE_BAUD | PROTOCOL_FEATURE_TIMESET |
+                 PROTOCOL_FEATURE_BLANK;
+      break;
+    case CMD_SYNC_ALL:
+      out[n++] = dstActive ? 1 : 0;
+      break;
+    case CMD_PING:
+      n += putU32(out + n, serialBaud);
+      break;
+    case CMD_VERBOSITY:
+    case CMD_QUERY_VERBOSITY:
+      out[n++] = verbosity();
+      out[n++] = txQueue.peak;
+      n += putU32(out + n, txWaitMaxUs);
+      break;
+    case CMD_AGING:
+    case CMD_QUERY_AGING:
+      out[n++] = (uint8_t)settings.aging;
+      n += putU32(out + n, settings.lastSetUtc);
+      break;
+    case CMD_TIME_SET_AT:
+      out[n++] = timeSet.armed ? 1 : 0;  // 0: rejected (no probe in the slot, or too late)
+      break;
+    case CMD_TIME_PROBE: {
+      uint32_t phase;
+      n += putU32(out + n, rtcTimeAt(probeMicros[lastProbeSlot], phase));
+      n += putU32(out + n, phase);
+      break;
+    }
+    // QC (nine counters) does not fit FRAME_MAX_BODY: status only, use the text command
+  }
+  return n;
+}
+
+// Send a reply frame: opcode | FRAME_REPLY, status, payload
+void sendReplyFrame(uint8_t op, uint8_t status, const uint8_t* payload, uint8_t len) {
+  uint8_t body[FRAME_MAX_BODY];
+  body[0] = op | FRAME_REPLY;
+  body[1] = status;
+  if (len) memcpy(body + 2, payload, len);  // payload may be NULL
+  uint8_t frame[FRAME_MAX_SIZE];
+  serialOut.write(frame, frameEncode(frame, body, len + 2));
+}
+
+// Decode and run one binary frame; the text replies are dropped and a reply frame sent instead
+void dispatchFrame(const uint8_t* body, uint8_t len) {
+  Command cmd;
+  uint8_t status = decodeCommand(body, len, cmd);
+  uint8_t payload[FRAME_MAX_BODY - 2];
+  uint8_t payloadLen = 0;
+  if (status == PARSE_OK) {
+    reply = &nullPrint;
+    dbg = &nullPrint;
+    runCommand(cmd);
+    applyVerbosity();
+    payloadLen = encodeReplyPayload(cmd.op, payload);
+  }
+  sendReplyFrame(status == PARSE_UNKNOWN ? body[0] : cmd.op, status, payload, payloadLen);
+}
+
+void readSerial() {
   // Read full line into buffer
   static char buf[64];
   static uint8_t pos = 0;
+  static uint32_t lastTextMs = 0;
 
   while (Serial.available()) {
     char c = Serial.read();
+    uint32_t now = millis();
+
+    // A partial line that went quiet is debris (e.g. the tail of a corrupt
+    // frame): a frame after the gap starts over instead of joining it
+    if (pos != 0 && (uint8_t)c == FRAME_SYNC && now - lastTextMs > FRAME_TIMEOUT_MS) {
+      pos = 0;
+    }
+
+    // Binary frame: FRAME_SYNC in place of the first character of a line
+    if (frameActive(frameRx, now) || (pos == 0 && (uint8_t)c == FRAME_SYNC)) {
+      uint8_t result = frameFeed(frameRx, c, now);
+      if (result == FRAME_READY) {
+        dispatchFrame(frameRx.body, frameRx.len);
+        applyPendingBaud();
+        return;
+      }
+      if (result == FRAME_BAD_CRC) {
+        sendReplyFrame(CMD_NONE, FRAME_STATUS_BAD_CRC, NULL, 0);
+      } else if (result == FRAME_BAD_LENGTH) {
+        sendReplyFrame(CMD_NONE, FRAME_STATUS_BAD_LENGTH, NULL, 0);
+      }
+      continue;
+    }
     
+    lastTextMs = now;
+
     // Check for line termination
     if (c == '\n' || c == '\r') {
       if (pos == 0) continue;  // skip empty lines
       buf[pos] = '\0';
       pos = 0;
 
-      Serial.print("DBG:RX ");
-      Serial.println(buf);
-
-      // Parse command from buffer
-      if (buf[0] == 'T') {
-        // T<hour>,<minute>,<second> - Browser sends LOCAL time, we store UTC in RTC
-        int h, m, s;
-        if (sscanf(buf + 1, "%d,%d,%d", &h, &m, &s) == 3 &&
-            h >= 0 && h <= 23 && m >= 0 && m <= 59 && s >= 0 && s <= 59) {
-          // Convert local time to UTC
-          int8_t offset = getTimezoneOffset(tzId);
-          if (dstActive) offset += 1;
-          int16_t utcHour = h - offset;
-          
-          // Handle day wrap (we'll keep same date for simplicity)
-          if (utcHour < 0) utcHour += 24;
-          if (utcHour >= 24) utcHour -= 24;
-          
-          DateTime now = rtc.now();
-          rtc.adjust(DateTime(now.year(), now.month(), now.day(), (uint8_t)utcHour, m, s));
-          updateDisplay();
-          Serial.print("OK:T");
-          Serial.print(h); Serial.print(":");
-          Serial.print(m); Serial.print(":");
-          Serial.println(s);
-        } else {
-          Serial.println("ERR:T expected h,m,s");
-        }
-      }
-      else if (buf[0] == 'D') {
-        // D<month>,<day>,<year> - Update date and recalculate DST
-        int m, d, y;
-        if (sscanf(buf + 1, "%d,%d,%d", &m, &d, &y) == 3 &&
-            m >= 1 && m <= 12 && d >= 1 && d <= 31 && y >= 2026 && y <= 2035) {
-          DateTime now = rtc.now();
-          rtc.adjust(DateTime(y, m, d, now.hour(), now.minute(), now.second()));
-          lastDateCheck = rtc.now();
-          checkAndApplyDST();  // Recalculate DST status with new date
-          updateDisplay();
-          Serial.print("OK:D");
-          Serial.print(m); Serial.print("/");
-          Serial.print(d); Serial.print("/");
-          Serial.println(y);
-        } else {
-          Serial.println("ERR:D expected m,d,y");
-        }
-      }
-      else if (buf[0] == 'Q' && buf[1] == 'F' && buf[2] == '\0') {
-        uint8_t stored = EEPROM.read(ADDR_FORMAT_12H);
-        if (stored > 1) stored = 0;
-        Serial.print("OK:QF");
-        Serial.println(stored);
-      }
-      else if (buf[0] == 'F') {
-        // F<0|1> (0=24h, 1=12h)
-        int f;
-        if (sscanf(buf + 1, "%d", &f) == 1 && (f == 0 || f == 1)) {
-          EEPROM.update(ADDR_FORMAT_12H, f);
-          updateDisplay();
-          uint8_t stored = EEPROM.read(ADDR_FORMAT_12H);
-          DateTime now = rtc.now();
-          // Calculate local time for debug output
-          int8_t offset = getTimezoneOffset(tzId);
-          if (dstActive) offset += 1;
-          int16_t localHour = (int16_t)now.hour() + offset;
-          if (localHour < 0) localHour += 24;
-          if (localHour >= 24) localHour -= 24;
-          uint8_t shownHour = (stored == 1) ? format12Hour((uint8_t)localHour) : (uint8_t)localHour;
-          Serial.print("DBG:F requested=");
-          Serial.print(f);
-          Serial.print(" stored=");
-          Serial.print(stored);
-          Serial.print(" rtcHour24UTC=");
-          Serial.print(now.hour());
-          Serial.print(" localHour=");
-          Serial.print(localHour);
-          Serial.print(" shownHour=");
-          Serial.println(shownHour);
-          Serial.print("OK:F");
-          Serial.println(stored);
-        } else {
-          Serial.println("ERR:F expected 0 or 1");
-        }
-      }
-      else if (buf[0] == 'Z') {
-        // Z<tz_id> (0-20)
-        // Timezone ID selector with DST rule dispatch
-        int z = atoi(buf + 1);
-        if (z >= 0 && z < NUM_TIMEZONES) {
-          EEPROM.update(ADDR_TZ_ID, z);
-          tzId = z;
-          
-          // Mark DST rules version
-          EEPROM.update(ADDR_DST_RULES_VERSION, DST_RULES_VERSION);
-          
-          checkAndApplyDST();
-          
-          // Find the timezone name and DST rule
-          const char* tzName = "Unknown";
-          uint8_t dstRule = DST_RULE_NONE;
-          for (uint8_t i = 0; i < NUM_TIMEZONES; i++) {
-            if (timezones[i].id == z) {
-              tzName = timezones[i].name;
-              dstRule = timezones[i].dst_rule;
-              break;
-            }
-          }
-          
-          Serial.print("OK:Z");
-          Serial.println(z);
-          Serial.print("DBG:TZ ");
-          Serial.print(tzName);
-          Serial.print(" rule=");
-          Serial.println(dstRule);
-        } else {
-          Serial.print("ERR:Z expected 0..");
-          Serial.println(NUM_TIMEZONES - 1);
-        }
-      }
-      else if (buf[0] == 'B') {
-        // B<0-7> (brightness)
-        int b = atoi(buf + 1);
-        if (b >= 0 && b <= 7) {
-          EEPROM.update(ADDR_BRIGHTNESS, b);
-          display.setBrightness(b);
-          updateDisplay();
-          Serial.print("OK:B");
-          Serial.println(b);
-        } else {
-          Serial.println("ERR:B expected 0..7");
-        }
-      }
-      else if (buf[0] == 'S' && buf[1] != '\0' && buf[2] == '\0') {
-        // S<0|1> - Enable (1) or disable (0) scheduled dimming
-        int s = atoi(buf + 1);
-        if (s == 0 || s == 1) {
-          scheduleEnabled = (s == 1);
-          EEPROM.update(ADDR_SCHEDULE_ENABLED, s);
-          Serial.print("OK:S");
-          Serial.println(s);
-        } else {
-          Serial.println("ERR:S expected 0 or 1");
-        }
-      }
-      else if (buf[0] == 'N') {
-        // N<h>,<m>,<b> - Set night (dim) time and brightness
-        int h, m, b;
-        if (sscanf(buf + 1, "%d,%d,%d", &h, &m, &b) == 3 &&
-            h >= 0 && h <= 23 && m >= 0 && m <= 59 && b >= 0 && b <= 7) {
-          dimHour = h;
-          dimMinute = m;
-          dimBrightness = b;
-          EEPROM.update(ADDR_DIM_HOUR, h);
-          EEPROM.update(ADDR_DIM_MINUTE, m);
-          EEPROM.update(ADDR_DIM_BRIGHTNESS, b);
-          currentlyDim = false;  // Force re-check on next cycle
-          Serial.print("OK:N");
-          Serial.print(h); Serial.print(":");
-          Serial.print(m); Serial.print(":");
-          Serial.println(b);
-        } else {
-          Serial.println("ERR:N expected h,m,b");
-        }
-      }
-      else if (buf[0] == 'Y') {
-        // Y<h>,<m>,<b> - Set day (bright) time and brightness
-        int h, m, b;
-        if (sscanf(buf + 1, "%d,%d,%d", &h, &m, &b) == 3 &&
-            h >= 0 && h <= 23 && m >= 0 && m <= 59 && b >= 0 && b <= 7) {
-          brightHour = h;
-          brightMinute = m;
-          brightBrightness = b;
-          EEPROM.update(ADDR_BRIGHT_HOUR, h);
-          EEPROM.update(ADDR_BRIGHT_MINUTE, m);
-          EEPROM.update(ADDR_BRIGHT_BRIGHTNESS, b);
-          currentlyDim = false;  // Force re-check on next cycle
-          Serial.print("OK:Y");
-          Serial.print(h); Serial.print(":");
-          Serial.print(m); Serial.print(":");
-          Serial.println(b);
-        } else {
-          Serial.println("ERR:Y expected h,m,b");
-        }
-      }
-      else if (buf[0] == 'Q' && buf[1] == 'S' && buf[2] == '\0') {
-        // QS - Query schedule settings
-        Serial.print("OK:QS enabled=");
-        Serial.print(scheduleEnabled ? 1 : 0);
-        Serial.print(",dim=");
-        if (dimHour < 10) Serial.print("0");
-        Serial.print(dimHour);
-        Serial.print(":");
-        if (dimMinute < 10) Serial.print("0");
-        Serial.print(dimMinute);
-        Serial.print(":");
-        Serial.print(dimBrightness);
-        Serial.print(",bright=");
-        if (brightHour < 10) Serial.print("0");
-        Serial.print(brightHour);
-        Serial.print(":");
-        if (brightMinute < 10) Serial.print("0");
-        Serial.print(brightMinute);
-        Serial.print(":");
-        Serial.println(brightBrightness);
-      }
-      else {
-        Serial.print("ERR:UNKNOWN ");
-        Serial.println(buf);
-      }
+      dbg->print(F("DBG:RX "));
+      dbg->println(buf);
 
+      dispatchCommand(buf);
+      applyPendingBaud();
       return;
     }
     else if (pos < sizeof(buf) - 1) {
       buf[pos++] = c;
     } else {
       pos = 0;
-      Serial.println("ERR:RX overflow");
+      perf.rxOverflows++;
+      if (verbosity() != VERBOSITY_SILENT) reply->println(F("ERR:RX overflow"));
     }
   }
 }
 
+// Read and run commands, then move queued output to the UART
+void handleSerial() {
+  if (!Serial.available() && txQueueEmpty(txQueue)) return;
+  uint32_t start = micros();
+  txWaitUs = 0;
+  readSerial();
+  if (txWaitUs > txWaitMaxUs) txWaitMaxUs = txWaitUs;
+  drainTx();
+  uint32_t elapsed = micros() - start;
+  if (elapsed > perf.serialMaxUs) perf.serialMaxUs = elapsed;
+}
+
+
+// Idle sleep until the next interrupt: the SQW edge, a received byte, the UART
+// transmitter or the millis() timer (every 1.024 ms). Idle keeps the UART and
+// the timers running, so serial input still wakes the loop; power-down would
+// stop the UART clock and lose the first byte.
+void idleUntilInterrupt() {
+#if SLEEP_BETWEEN_TICKS
+  if (timeSet.armed || !txQueueEmpty(txQueue)) return;  // Serviced on every pass
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  noInterrupts();
+  if (!tickPending && !Serial.available()) {
+    sleep_enable();
+    interrupts();  // The instruction after sei always runs first: no wakeup is lost
+    sleep_cpu();
+    sleep_disable();
+  }
+  interrupts();
+#endif
+}
 
 void setup() {
-  Serial.begin(9600);
+  Serial.begin(SERIAL_BAUD_DEFAULT);  // Always the default at boot; faster rates are negotiated (U)
+  power_adc_disable();  // No analog inputs
   Wire.begin();
   rtc.begin();
-  
-  Serial.println("DBG:Boot");
-  Serial.print("DBG:DST_RULES_VERSION=");
-  Serial.println(DST_RULES_VERSION);
+  // After rtc.begin(): (re)initialising the TWI resets the bus to 100 kHz
+  Wire.setClock(I2C_CLOCK_HZ);
 
-  // Load settings from EEPROM
-  uint8_t brightness = EEPROM.read(ADDR_BRIGHTNESS);
-  if (brightness > 7) brightness = 5;
-  display.setBrightness(brightness);
+  // 1 Hz square wave on SQW; the edge timestamp is used for latency stats in both tick modes
+  rtc.writeSqwPinMode(DS3231_SquareWave1Hz);
+  pinMode(SQW_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(SQW_PIN), onSqwTick, FALLING);
   
-  // Load timezone ID
-  uint8_t tzByte = EEPROM.read(ADDR_TZ_ID);
-  if (tzByte >= NUM_TIMEZONES) {
-    tzId = 0;  // Default UTC
-  } else {
-    tzId = tzByte;
-  }
+  // Load settings from EEPROM (once; everything else uses the RAM copy)
+  loadSettings();
+  applyVerbosity();
+  writeAgingOffset(settings.aging);  // Lost with the RTC's power; the EEPROM copy is the master
+  dbg->println(F("DBG:Boot"));
+  dbg->print(F("DBG:DST_RULES_VERSION="));
+  dbg->println(DST_RULES_VERSION);
+  setDisplayBrightness(settings.brightness);
   
   // Check DST rules version compatibility
-  uint8_t storedVersion = EEPROM.read(ADDR_DST_RULES_VERSION);
+  uint8_t storedVersion = settings.dstRulesVersion;
   if (storedVersion != DST_RULES_VERSION && storedVersion != 0) {
-    Serial.print("DBG:RULE_VERSION_MISMATCH stored=");
-    Serial.print(storedVersion);
-    Serial.print(" current=");
-    Serial.println(DST_RULES_VERSION);
+    dbg->print(F("DBG:RULE_VERSION_MISMATCH stored="));
+    dbg->print(storedVersion);
+    dbg->print(F(" current="));
+    dbg->println(DST_RULES_VERSION);
   }
   
-  // Initialize date checking for auto-increment
-  lastDateCheck = rtc.now();
+  readClock();
   
   // Check initial DST status
   checkAndApplyDST();
+  lastLocalDay = snapshotLocalDay();  // Day-change detection starts from the boot reading
   
-  Serial.print("DBG:Timezone=");
-  for (uint8_t i = 0; i < NUM_TIMEZONES; i++) {
-    if (timezones[i].id == tzId) {
-      Serial.println(timezones[i].name);
-      break;
-    }
-  }
+  dbg->print(F("DBG:Timezone="));
+  printTimezoneName(*dbg, settings.tzId);
+  dbg->println();
 
-  // Load scheduled brightness settings from EEPROM
-  uint8_t schedByte = EEPROM.read(ADDR_SCHEDULE_ENABLED);
-  scheduleEnabled = (schedByte == 1);
-  
-  uint8_t dh = EEPROM.read(ADDR_DIM_HOUR);
-  uint8_t dm = EEPROM.read(ADDR_DIM_MINUTE);
-  uint8_t bh = EEPROM.read(ADDR_BRIGHT_HOUR);
-  uint8_t bm = EEPROM.read(ADDR_BRIGHT_MINUTE);
-  uint8_t db = EEPROM.read(ADDR_DIM_BRIGHTNESS);
-  uint8_t bb = EEPROM.read(ADDR_BRIGHT_BRIGHTNESS);
-  
-  // Validate and use defaults if corrupted
-  dimHour = (dh <= 23) ? dh : 22;
-  dimMinute = (dm <= 59) ? dm : 0;
-  brightHour = (bh <= 23) ? bh : 7;
-  brightMinute = (bm <= 59) ? bm : 0;
-  dimBrightness = (db <= 7) ? db : 1;
-  brightBrightness = (bb <= 7) ? bb : 5;
-  
-  Serial.print("DBG:Schedule enabled=");
-  Serial.println(scheduleEnabled);
+  dbg->print(F("DBG:Schedule enabled="));
+  dbg->println(settings.scheduleEnabled);
+  dbg->print(F("DBG:FreeRAM="));
+  dbg->println(freeMemory());
 
   updateDisplay();
 }
 
 void loop() {
+  perf.loops++;
   handleSerial();
-  
+  checkBaudFallback();
+  serviceTimeSet();
+
+#if TICK_FROM_SQW
+  // Only do clock work once per RTC second; serial is serviced on every pass
+  if (!tickPending && millis() - lastTickMillis < SQW_TIMEOUT_MS) {
+    idleUntilInterrupt();
+    return;
+  }
+  noInterrupts();
+  bool fromSqw = tickPending;
+  uint32_t edgeMicros = tickMicros;
+  tickPending = false;
+  interrupts();
+  lastTickMillis = millis();
+#endif
+
+  uint32_t tickStart = micros();
+#if TICK_FROM_SQW
+  // Fallback ticks (no SQW edge) have no edge time to measure against
+  if (fromSqw && tickStart - edgeMicros > perf.tickLateMaxUs) {
+    perf.tickLateMaxUs = tickStart - edgeMicros;
+  }
+#endif
+  perf.ticks++;
+
+  // Single RTC read per tick; everything below uses clockNow
+  readClock();
+
+  // Persist coalesced setting changes
+  commitSettingsIfIdle();
+
   // Check and apply scheduled brightness
   checkScheduledBrightness();
   
-  // Auto-increment date every 24 hours
-  autoIncrementDate();
+  // Once per local calendar day
+  checkDayChange();
   
   updateDisplay();
+
+  uint32_t tickWork = micros() - tickStart;
+  if (tickWork > perf.tickWorkMaxUs) perf.tickWorkMaxUs = tickWork;
+
+#if !TICK_FROM_SQW
   delay(500);
+#endif
 }
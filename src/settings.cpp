@@ -0,0 +1,91 @@
+#include "settings.h"
+#include <string.h>
+#include "crc16.h"
+
+void settingsDefaults(Settings& s) {
+  memset(&s, 0, sizeof(s));
+  s.brightness = 5;
+  s.format12h = 0;
+  s.tzId = 0;
+  s.dstRulesVersion = 0;
+  s.scheduleEnabled = 0;
+  s.dimHour = 22;
+  s.dimMinute = 0;
+  s.dimBrightness = 1;
+  s.brightHour = 7;
+  s.brightMinute = 0;
+  s.brightBrightness = 5;
+  s.quiet = 0;
+  s.aging = 0;
+  s.lastSetUtc = 0;
+  s.nightBlank = 0;
+}
+
+void settingsSanitize(Settings& s, uint8_t maxTzId) {
+  Settings d;
+  settingsDefaults(d);
+  if (s.brightness > 7) s.brightness = d.brightness;
+  if (s.format12h > 1) s.format12h = d.format12h;
+  if (s.tzId > maxTzId) s.tzId = d.tzId;
+  if (s.scheduleEnabled > 1) s.scheduleEnabled = d.scheduleEnabled;
+  if (s.dimHour > 23) s.dimHour = d.dimHour;
+  if (s.dimMinute > 59) s.dimMinute = d.dimMinute;
+  if (s.dimBrightness > 7) s.dimBrightness = d.dimBrightness;
+  if (s.brightHour > 23) s.brightHour = d.brightHour;
+  if (s.brightMinute > 59) s.brightMinute = d.brightMinute;
+  if (s.brightBrightness > 7) s.brightBrightness = d.brightBrightness;
+  if (s.quiet > 2) s.quiet = d.quiet;
+  if (s.nightBlank > 1) s.nightBlank = d.nightBlank;
+}
+
+static uint16_t slotAddress(uint8_t slot) {
+  return SETTINGS_RING_START + (uint16_t)slot * SETTINGS_RECORD_SIZE;
+}
+
+static uint16_t recordCrc(const SettingsRecord& r) {
+  return crc16((const uint8_t*)&r, SETTINGS_RECORD_SIZE - sizeof(r.crc));
+}
+
+bool settingsLoad(Settings& out, SettingsRing& ring, SettingsReadByte readByte) {
+  ring.valid = false;
+  ring.slot = SETTINGS_SLOT_COUNT - 1;  // So the first commit lands in slot 0
+  ring.sequence = 0;
+
+  SettingsRecord r;
+  for (uint8_t slot = 0; slot < SETTINGS_SLOT_COUNT; slot++) {
+    uint16_t addr = slotAddress(slot);
+    uint8_t* p = (uint8_t*)&r;
+    for (uint16_t i = 0; i < SETTINGS_RECORD_SIZE; i++) {
+      p[i] = readByte(addr + i);
+    }
+    if (r.version != SETTINGS_VERSION || r.crc != recordCrc(r)) continue;
+
+    // Serial-number comparison so the sequence may wrap
+    if (!ring.valid || (int16_t)(r.sequence - ring.sequence) > 0) {
+      ring.valid = true;
+      ring.slot = slot;
+      ring.sequence = r.sequence;
+      out = r.settings;
+    }
+  }
+  return ring.valid;
+}
+
+void settingsCommit(const Settings& s, SettingsRing& ring, SettingsWriteByte writeByte) {
+  SettingsRecord r;
+  r.version = SETTINGS_VERSION;
+  r.sequence = ring.sequence + 1;
+  r.settings = s;
+  r.crc = recordCrc(r);
+
+  uint8_t slot = (ring.slot + 1) % SETTINGS_SLOT_COUNT;
+  uint16_t addr = slotAddress(slot);
+  const uint8_t* p = (const uint8_t*)&r;
+  for (uint16_t i = 0; i < SETTINGS_RECORD_SIZE; i++) {
+    writeByte(addr + i, p[i]);
+  }
+
+  ring.slot = slot;
+  ring.sequence = r.sequence;
+  ring.valid = true;
+}
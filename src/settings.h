@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stdint.h>
+
+// Persisted settings: one versioned, CRC-checked record, loaded into RAM at boot.
+// Commits append a new record to a wear-levelled ring in EEPROM; the newest valid
+// record (highest sequence number) wins. No hardware dependencies: EEPROM access
+// is passed in by the caller so the ring logic runs in native tests.
+
+#define SETTINGS_VERSION 1
+
+// Ring location: everything above the legacy single-byte layout (0x00-0x0A)
+#define SETTINGS_RING_START 0x40
+#define SETTINGS_RING_END   0x400  // ATmega328P: 1 KB EEPROM
+
+struct Settings {
+  uint8_t brightness;        // 0-7
+  uint8_t format12h;         // 0=24h, 1=12h
+  uint8_t tzId;              // Timezone ID
+  uint8_t dstRulesVersion;   // DST rules version the timezone was set under
+  uint8_t scheduleEnabled;   // 0=off, 1=on
+  uint8_t dimHour;           // 0-23
+  uint8_t dimMinute;         // 0-59
+  uint8_t dimBrightness;     // 0-7 (brightness during dim period)
+  uint8_t brightHour;        // 0-23
+  uint8_t brightMinute;      // 0-59
+  uint8_t brightBrightness;  // 0-7 (brightness during bright period)
+  uint8_t quiet;             // Output level below debug: VERBOSITY_DEBUG - level (command.h);
+                             // 0 in records written before the field existed
+  int8_t aging;              // DS3231 aging offset (G): +1 slows the RTC by about 0.1 ppm
+  uint32_t lastSetUtc;       // Unix time of the last precise time set (W), 0 if none since
+                             // the clock was set another way; the baseline for drift
+  uint8_t nightBlank;        // 0=dim, 1=blank the display in the scheduled dim period (K)
+  uint8_t reserved[1];       // Zero; room for new fields without changing the record size
+} __attribute__((packed));
+
+struct SettingsRecord {
+  uint8_t version;     // SETTINGS_VERSION
+  uint16_t sequence;   // Incremented on every commit (wraps)
+  Settings settings;
+  uint16_t crc;        // crc16() over all preceding bytes
+} __attribute__((packed));
+
+#define SETTINGS_RECORD_SIZE ((uint16_t)sizeof(SettingsRecord))
+#define SETTINGS_SLOT_COUNT  ((SETTINGS_RING_END - SETTINGS_RING_START) / SETTINGS_RECORD_SIZE)
+
+// EEPROM byte access supplied by the caller (EEPROM on the device, an array in tests)
+typedef uint8_t (*SettingsReadByte)(uint16_t addr);
+typedef void (*SettingsWriteByte)(uint16_t addr, uint8_t value);
+
+// Where the newest record lives; kept in RAM so commits don't rescan the ring
+struct SettingsRing {
+  uint8_t slot;       // Slot of the newest valid record
+  uint16_t sequence;  // Its sequence number
+  bool valid;         // false if no valid record was found
+};
+
+// Factory defaults (UTC, 24h, brightness 5, dim 22:00@1, bright 07:00@5, schedule off,
+// debug output, no aging offset)
+void settingsDefaults(Settings& s);
+
+// Clamp out-of-range fields to their defaults; maxTzId is the highest valid timezone ID
+void settingsSanitize(Settings& s, uint8_t maxTzId);
+
+// Scan the ring for the newest valid record. Returns false (and leaves out untouched)
+// if there is none, e.g. on first boot after upgrading from the legacy layout.
+bool settingsLoad(Settings& out, SettingsRing& ring, SettingsReadByte readByte);
+
+// Write s as the next record in the ring. Only changed bytes are written if
+// writeByte is an update-style function.
+void settingsCommit(const Settings& s, SettingsRing& ring, SettingsWriteByte writeByte);
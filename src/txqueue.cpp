@@ -0,0 +1,25 @@
+#include "txqueue.h"
+
+void txQueueReset(TxQueue& q) {
+  q.head = 0;
+  q.count = 0;
+  q.peak = 0;
+}
+
+bool txQueuePut(TxQueue& q, uint8_t b) {
+  if (q.count == TX_QUEUE_SIZE) return false;
+  q.buf[(uint8_t)(q.head + q.count) % TX_QUEUE_SIZE] = b;
+  q.count++;
+  if (q.count > q.peak) q.peak = q.count;
+  return true;
+}
+
+uint8_t txQueueTake(TxQueue& q, uint8_t* out, uint8_t max) {
+  uint8_t n = 0;
+  while (n < max && q.count > 0) {
+    out[n++] = q.buf[q.head];
+    q.head = (q.head + 1) % TX_QUEUE_SIZE;
+    q.count--;
+  }
+  return n;
+}
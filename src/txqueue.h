@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+
+// Software transmit queue in front of the UART. Replies are queued in full and
+// moved into the hardware TX buffer only as far as it has room, so printing a
+// reply never waits for the line. No hardware dependencies: the caller moves
+// bytes to the UART (txQueueTake) and the native tests run the ring directly.
+
+#define TX_QUEUE_SIZE 128  // Plus the 64-byte hardware buffer: fits OK:A with the DBG:RX echo
+
+struct TxQueue {
+  uint8_t head;       // Next byte out
+  uint8_t count;      // Bytes queued
+  uint8_t peak;       // Highest count seen (for QV)
+  uint8_t buf[TX_QUEUE_SIZE];
+};
+
+void txQueueReset(TxQueue& q);
+
+// Append one byte; false if the queue is full
+bool txQueuePut(TxQueue& q, uint8_t b);
+
+// Remove up to max bytes from the front into out. Returns the number removed.
+uint8_t txQueueTake(TxQueue& q, uint8_t* out, uint8_t max);
+
+inline bool txQueueEmpty(const TxQueue& q) { return q.count == 0; }
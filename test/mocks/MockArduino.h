@@ -0,0 +1,126 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include "mock_timing.h"
+
+// Arduino core stand-in for the native simulator (HAL_NATIVE, see src/hal.h):
+// Print, flash-string macros, virtual-time millis()/micros(), pins and interrupts
+
+typedef uint8_t byte;
+
+// Flash is ordinary memory on the host
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define memcpy_P memcpy
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+#define DEC 10
+
+// Print: the subset of the Arduino API the firmware uses, decimal only
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t b) = 0;
+
+    virtual size_t write(const uint8_t* buf, size_t size) {
+        for (size_t i = 0; i < size; i++) write(buf[i]);
+        return size;
+    }
+
+    size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t print(const __FlashStringHelper* s) { return print(reinterpret_cast<const char*>(s)); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char v, int = DEC) { return print((unsigned long)v); }
+    size_t print(int v, int = DEC) { return print((long)v); }
+    size_t print(unsigned int v, int = DEC) { return print((unsigned long)v); }
+    size_t print(long v, int = DEC) { return printNumber("%ld", v); }
+    size_t print(unsigned long v, int = DEC) { return printNumber("%lu", v); }
+
+    size_t println() { return print("\r\n"); }
+    template <typename T> size_t println(T v) { size_t n = print(v); return n + println(); }
+
+private:
+    template <typename T> size_t printNumber(const char* format, T v) {
+        char buf[24];
+        snprintf(buf, sizeof(buf), format, v);
+        return print(buf);
+    }
+};
+
+// Timing: virtual time, advanced by the test or the simulator
+inline uint32_t millis() { return MockTiming::millis(); }
+inline uint32_t micros() { return MockTiming::micros(); }
+inline void delay(uint32_t ms) { MockTiming::advanceMillis(ms); }
+inline void delayMicroseconds(uint32_t us) { MockTiming::advanceMicros(us); }
+
+// Pins and external interrupts (INT0 = D2, INT1 = D3)
+#define INPUT        0
+#define OUTPUT       1
+#define INPUT_PULLUP 2
+#define FALLING      2
+#define digitalPinToInterrupt(p) ((p) == 2 ? 0 : ((p) == 3 ? 1 : -1))
+
+inline void (*mockInterruptHandlers[2])() = {nullptr, nullptr};
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void attachInterrupt(uint8_t interrupt, void (*handler)(), int) {
+    if (interrupt < 2) mockInterruptHandlers[interrupt] = handler;
+}
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+// Raise an external interrupt (e.g. the DS3231 SQW edge on INT0)
+inline void mockFireInterrupt(uint8_t interrupt) {
+    if (interrupt < 2 && mockInterruptHandlers[interrupt]) mockInterruptHandlers[interrupt]();
+}
+
+// I2C: the mocked RTC needs no bus for RTClib calls. Raw register writes
+// (beginTransmission / write / endTransmission) go to the device attached at
+// the address, if any.
+typedef void (*MockWireReceiver)(void* device, const uint8_t* data, uint8_t len);
+
+class MockWireClass {
+private:
+    uint8_t txAddress = 0;
+    uint8_t txBuffer[32];
+    uint8_t txLength = 0;
+    MockWireReceiver receivers[128] = {};
+    void* devices[128] = {};
+
+public:
+    void begin() {}
+    void setClock(uint32_t hz) { clockHz = hz; }
+    uint32_t clockHz = 100000;
+    uint32_t transmissions = 0;
+
+    void attach(uint8_t address, MockWireReceiver receiver, void* device) {
+        receivers[address & 0x7F] = receiver;
+        devices[address & 0x7F] = device;
+    }
+
+    void beginTransmission(uint8_t address) {
+        txAddress = address & 0x7F;
+        txLength = 0;
+    }
+
+    size_t write(uint8_t b) {
+        if (txLength >= sizeof(txBuffer)) return 0;
+        txBuffer[txLength++] = b;
+        return 1;
+    }
+
+    uint8_t endTransmission(bool = true) {
+        transmissions++;
+        if (!receivers[txAddress]) return 2;  // Address NACK
+        receivers[txAddress](devices[txAddress], txBuffer, txLength);
+        return 0;
+    }
+};
+
+inline MockWireClass MockWire;
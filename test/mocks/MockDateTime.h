@@ -1,4 +1,6 @@
 #pragma once
+#include <stdint.h>
+#include "datetime.h"
 
 // Minimal mock DateTime class compatible with RTClib's DateTime
 // Used for testing DST and date handling logic without hardware
@@ -18,6 +20,18 @@ struct MockDateTime {
         : _year(year), _month(month), _day(day),
           _hour(hour), _minute(minute), _second(second) {}
 
+    // Seconds since 1970-01-01 (RTClib: DateTime(uint32_t) / unixtime())
+    explicit MockDateTime(uint32_t t) {
+        civilFromDays(t / 86400, _year, _month, _day);
+        _hour = (t / 3600) % 24;
+        _minute = (t / 60) % 60;
+        _second = t % 60;
+    }
+
+    uint32_t unixtime() const {
+        return (uint32_t)daysFromCivil(_year, _month, _day) * 86400 + _hour * 3600UL + _minute * 60 + _second;
+    }
+
     uint16_t year() const { return _year; }
     uint8_t month() const { return _month; }
     uint8_t day() const { return _day; }
@@ -1,4 +1,5 @@
 #pragma once
+#include <stdint.h>
 #include <string.h>
 
 // Mock EEPROM implementation using a simple array
@@ -8,8 +9,10 @@ private:
     uint8_t data[EEPROM_SIZE];
 
 public:
+    uint32_t writeCount = 0;  // Bytes actually written (wear)
+
     MockEEPROMClass() {
-        std::memset(data, 0, EEPROM_SIZE);
+        erase();
     }
 
     uint8_t read(int address) {
@@ -20,17 +23,23 @@ public:
     void write(int address, uint8_t value) {
         if (address < 0 || address >= EEPROM_SIZE) return;
         data[address] = value;
+        writeCount++;
     }
 
     void update(int address, uint8_t value) {
-        // In real EEPROM, update only writes if value differs
-        // For testing, just write
-        write(address, value);
+        // As on the device: unchanged bytes are not written
+        if (read(address) != value) write(address, value);
     }
 
     void clear() {
-        std::memset(data, 0, EEPROM_SIZE);
+        memset(data, 0, EEPROM_SIZE);
+    }
+
+    // Erased EEPROM reads 0xFF (a new board)
+    void erase() {
+        memset(data, 0xFF, EEPROM_SIZE);
+        writeCount = 0;
     }
 };
 
-extern MockEEPROMClass MockEEPROM;
+inline MockEEPROMClass MockEEPROM;
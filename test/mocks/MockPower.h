@@ -0,0 +1,90 @@
+#pragma once
+#include <stdint.h>
+#include "mock_timing.h"
+
+// <avr/sleep.h> and <avr/power.h> stand-ins, and the simulator's current model.
+// The simulator calls account() before every loop() pass: the virtual time since
+// the previous pass was spent asleep if the firmware reached sleep_cpu(), else
+// running. Currents are typical figures, not measurements:
+//   ATmega328P at 16 MHz, 5 V (datasheet typical characteristics): active
+//   9.2 mA, idle 2.6 mA, ADC enabled +0.3 mA. In idle the millis() timer still
+//   wakes the CPU every 1.024 ms for its interrupt and one loop() pass, about
+//   MOCK_WAKE_PASS_US of active time.
+//   Tick work (an RTC read, and a display write once a minute) takes no virtual
+//   time, so it is not counted; it is well under a millisecond per second.
+//   The USB-serial chip, the regulator and the power LED of a Nano board are not
+//   included.
+
+#define SLEEP_MODE_IDLE     0
+#define SLEEP_MODE_PWR_DOWN 2
+
+#define MOCK_MCU_ACTIVE_MA  9.2
+#define MOCK_MCU_IDLE_MA    2.6
+#define MOCK_ADC_MA         0.3
+#define MOCK_TIMER0_US      1024.0
+#define MOCK_WAKE_PASS_US   30.0
+
+class MockPowerClass {
+private:
+    uint64_t lastMicros = 0;
+    bool sleeping = false;    // sleep_cpu() reached since the last pass
+    bool sleepEnabled = false;
+
+public:
+    uint8_t sleepMode = SLEEP_MODE_IDLE;
+    bool adcEnabled = true;
+    uint64_t activeUs = 0;
+    uint64_t idleUs = 0;
+    double displayCharge = 0;  // mA * µs
+
+    void reset() {
+        lastMicros = MockTiming::nowMicros();
+        sleeping = false;
+        activeUs = idleUs = 0;
+        displayCharge = 0;
+    }
+
+    void enable() { sleepEnabled = true; }
+    void disable() { sleepEnabled = false; }
+    void sleep() { if (sleepEnabled) sleeping = true; }
+
+    // Book the time since the last pass; the CPU is awake for the next one
+    void account(double displayMa) {
+        uint64_t now = MockTiming::nowMicros();
+        uint64_t span = now - lastMicros;
+        lastMicros = now;
+        if (sleeping) idleUs += span;
+        else activeUs += span;
+        displayCharge += displayMa * (double)span;
+        sleeping = false;
+    }
+
+    double totalUs() const { return (double)(activeUs + idleUs); }
+
+    // Average MCU current over the accounted time, timer wakeups included
+    double mcuAverageMa() const {
+        if (totalUs() == 0) return 0;
+        double wakeUs = (double)idleUs / MOCK_TIMER0_US * MOCK_WAKE_PASS_US;
+        double runUs = (double)activeUs + wakeUs;
+        double sleepUs = (double)idleUs - wakeUs;
+        double ma = (runUs * MOCK_MCU_ACTIVE_MA + sleepUs * MOCK_MCU_IDLE_MA) / totalUs();
+        return ma + (adcEnabled ? MOCK_ADC_MA : 0);
+    }
+
+    // The same firmware without sleeping: active the whole time
+    double mcuAlwaysActiveMa() const {
+        return MOCK_MCU_ACTIVE_MA + (adcEnabled ? MOCK_ADC_MA : 0);
+    }
+
+    double displayAverageMa() const {
+        return totalUs() == 0 ? 0 : displayCharge / totalUs();
+    }
+};
+
+inline MockPowerClass MockPower;
+
+inline void set_sleep_mode(uint8_t mode) { MockPower.sleepMode = mode; }
+inline void sleep_enable() { MockPower.enable(); }
+inline void sleep_disable() { MockPower.disable(); }
+inline void sleep_cpu() { MockPower.sleep(); }
+inline void power_adc_disable() { MockPower.adcEnabled = false; }
@@ -0,0 +1,100 @@
+#pragma once
+#include <stdint.h>
+#include "MockArduino.h"
+#include "MockDateTime.h"
+#include "mock_timing.h"
+
+// Mock DS3231 (RTClib RTC_DS3231 subset). The time runs with virtual time: a
+// seconds count set by adjust() plus the RTC time elapsed since, at the rate of
+// a crystal that is driftPpm fast, trimmed by the aging offset register (written
+// over MockWire like the real chip; +1 slows it by 0.1 ppm).
+
+enum Ds3231SqwPinMode {
+    DS3231_OFF = 0x1C,
+    DS3231_SquareWave1Hz = 0x00,
+};
+
+#define MOCK_DS3231_ADDRESS   0x68
+#define MOCK_DS3231_REG_AGING 0x10
+
+class MockRTC {
+private:
+    uint32_t baseTime = MockDateTime(2026, 1, 1).unixtime();
+    uint64_t baseMicros = 0;  // Virtual time of the last adjust() or rate change
+    double baseElapsedUs = 0; // RTC time already elapsed past baseTime at baseMicros
+    int8_t agingRegister = 0;
+    double crystalPpm = 0;
+
+    double rate() const {
+        return 1.0 + (crystalPpm - 0.1 * agingRegister) * 1e-6;
+    }
+
+    double elapsedUs() const {
+        return baseElapsedUs + (double)(MockTiming::nowMicros() - baseMicros) * rate();
+    }
+
+    // Keep the time so far when the rate changes
+    void rebase() {
+        baseElapsedUs = elapsedUs();
+        baseMicros = MockTiming::nowMicros();
+    }
+
+    static void onWire(void* device, const uint8_t* data, uint8_t len) {
+        MockRTC* rtc = (MockRTC*)device;
+        if (len >= 2 && data[0] == MOCK_DS3231_REG_AGING) {
+            rtc->rebase();
+            rtc->agingRegister = (int8_t)data[1];
+        }
+    }
+
+public:
+    uint32_t adjustCount = 0;  // RTC writes
+    uint32_t readCount = 0;    // RTC reads
+    Ds3231SqwPinMode sqwMode = DS3231_OFF;
+
+    MockRTC() { MockWire.attach(MOCK_DS3231_ADDRESS, onWire, this); }
+
+    bool begin() { return true; }
+
+    MockDateTime now() {
+        readCount++;
+        return MockDateTime(unixtime());
+    }
+
+    void adjust(const MockDateTime& dt) {
+        adjustCount++;
+        baseTime = dt.unixtime();
+        baseMicros = MockTiming::nowMicros();
+        baseElapsedUs = 0;  // Writing the seconds restarts the countdown
+    }
+
+    void writeSqwPinMode(Ds3231SqwPinMode mode) { sqwMode = mode; }
+
+    // Test helpers
+    uint32_t unixtime() const {
+        return baseTime + (uint32_t)(elapsedUs() / 1000000);
+    }
+
+    // Crystal error, and the aging offset register (also cleared by a power loss)
+    void setDriftPpm(double ppm) {
+        rebase();
+        crystalPpm = ppm;
+    }
+
+    void setAging(int8_t aging) {
+        rebase();
+        agingRegister = aging;
+    }
+
+    int8_t aging() const { return agingRegister; }
+
+    // Virtual time of the next seconds-register update (the SQW falling edge)
+    uint64_t nextSecondMicros() const {
+        uint64_t second = (uint64_t)(elapsedUs() / 1000000) + 1;
+        double untilUs = ((double)second * 1000000 - baseElapsedUs) / rate();
+        uint64_t edge = baseMicros + (uint64_t)untilUs;
+        // Round up onto the edge itself (unixtime() must already read the new second)
+        while ((uint64_t)(baseElapsedUs + (double)(edge - baseMicros) * rate()) < second * 1000000) edge++;
+        return edge;
+    }
+};
@@ -2,16 +2,24 @@
 #include <string>
 #include <queue>
 #include <cstring>
+#include "MockArduino.h"
 
-// Mock Serial implementation for testing command parsing
-class MockSerialClass {
+// Mock Serial implementation for testing command parsing.
+// Output is collected as a string; the UART transmits instantly.
+class MockSerialClass : public Print {
 private:
     std::queue<char> inputBuffer;
     std::string outputBuffer;
 
 public:
+    uint32_t baud = 0;
+
     MockSerialClass() {}
 
+    void begin(uint32_t rate) { baud = rate; }
+    void end() {}
+    void flush() {}
+
     // Simulate Serial.available()
     int available() {
         return inputBuffer.size();
@@ -25,28 +33,16 @@ public:
         return (int)c;
     }
 
-    // Simulate Serial.print()
-    void print(const char* s) {
-        outputBuffer += s;
-    }
-
-    void print(int value) {
-        outputBuffer += std::to_string(value);
-    }
-
-    void print(char c) {
-        outputBuffer += c;
-    }
-
-    // Simulate Serial.println()
-    void println(const char* s = "") {
-        outputBuffer += s;
-        outputBuffer += "\n";
+    // Hardware TX buffer is always empty
+    int availableForWrite() {
+        return 64;
     }
 
-    void println(int value) {
-        outputBuffer += std::to_string(value);
-        outputBuffer += "\n";
+    // Simulate Serial.print()/println() (through Print)
+    using Print::write;
+    size_t write(uint8_t b) {
+        outputBuffer += (char)b;
+        return 1;
     }
 
     // Test helpers
@@ -71,4 +67,4 @@ public:
     }
 };
 
-extern MockSerialClass MockSerial;
+inline MockSerialClass MockSerial;
@@ -0,0 +1,40 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+
+// Display current model for the simulator (typical figures, not measured): each
+// segment is driven at about 20 mA for 1/6 of the scan (six grids), for the
+// pulse width the brightness selects (TM1637 datasheet: 1/16 .. 14/16).
+#define MOCK_TM1637_SEGMENT_MA (20.0 / 6)
+
+// Mock TM1637Display: keeps the last frame and brightness, counts transfers
+class MockTM1637 {
+public:
+    uint8_t segments[4] = {0, 0, 0, 0};
+    uint8_t brightness = 7;
+    bool on = true;
+    uint32_t transfers = 0;  // setSegments() calls (bit-banged transfers on the device)
+
+    MockTM1637(uint8_t, uint8_t) {}
+
+    void setBrightness(uint8_t b, bool displayOn = true) {
+        brightness = b;
+        on = displayOn;
+    }
+
+    void setSegments(const uint8_t data[], uint8_t length = 4, uint8_t pos = 0) {
+        memcpy(segments + pos, data, length);
+        transfers++;
+    }
+
+    // Average LED current of the frame on display, mA
+    double currentMa() const {
+        static const uint8_t pulseWidth16[8] = {1, 2, 4, 10, 11, 12, 13, 14};
+        if (!on) return 0;
+        uint8_t lit = 0;
+        for (uint8_t i = 0; i < 4; i++) {
+            for (uint8_t bit = 0; bit < 8; bit++) lit += (segments[i] >> bit) & 1;
+        }
+        return lit * MOCK_TM1637_SEGMENT_MA * pulseWidth16[brightness & 7] / 16;
+    }
+};
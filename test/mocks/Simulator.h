@@ -0,0 +1,100 @@
+#pragma once
+#include <string>
+#include "hal.h"
+
+// Native simulator: the firmware's own setup()/loop() (src/main.cpp built with
+// HAL_NATIVE) against the mocks, in virtual time. Time jumps from one RTC second
+// to the next; each second raises the SQW interrupt and runs the tick, so a
+// simulated year takes seconds of host time. Serial input is handled between
+// ticks, like a host that sends a line and waits for the reply. MockPower books
+// the time between loop() passes as asleep or running (see simLoop()).
+
+void setup();
+void loop();
+extern RTC_DS3231 rtc;
+extern TM1637Display display;
+
+// Power-on: fresh EEPROM unless keepEeprom (else a new board: perfect crystal,
+// aging register clear), RTC at utc, then setup()
+inline void simBoot(const MockDateTime& utc, bool keepEeprom = false) {
+    if (!keepEeprom) {
+        MockEEPROM.erase();
+        rtc.setDriftPpm(0);
+        rtc.setAging(0);
+    }
+    MockTiming::reset();
+    MockSerial.clearInput();
+    MockSerial.clearOutput();
+    rtc.adjust(utc);
+    rtc.adjustCount = 0;
+    MockPower.reset();
+    setup();
+}
+
+// One loop() pass, after booking the time since the previous one
+inline void simLoop() {
+    MockPower.account(display.currentMa());
+    loop();
+}
+
+// Run loop() until the serial input is consumed (bounded, in case nothing reads it)
+inline void simDrainInput() {
+    for (int i = 0; i < 256 && MockSerial.available(); i++) simLoop();
+    simLoop();
+}
+
+// Advance to the next RTC second, raise SQW and run the tick, then the pass that
+// finds nothing to do (and sleeps until the next edge)
+inline void simTick() {
+    MockTiming::setMicros(rtc.nextSecondMicros());
+    mockFireInterrupt(0);
+    simLoop();
+    simLoop();
+}
+
+inline void simRunSeconds(uint32_t seconds) {
+    for (uint32_t i = 0; i < seconds; i++) simTick();
+}
+
+// Run loop() every stepUs of virtual time for a span, raising SQW at each RTC
+// second on the way (for work scheduled between ticks, like a W time set)
+inline void simRunMicros(uint64_t span, uint32_t stepUs = 1000) {
+    uint64_t end = MockTiming::nowMicros() + span;
+    while (MockTiming::nowMicros() < end) {
+        uint64_t next = MockTiming::nowMicros() + stepUs;
+        if (next > end) next = end;
+        uint64_t edge = rtc.nextSecondMicros();
+        if (edge <= next) {
+            MockTiming::setMicros(edge);
+            mockFireInterrupt(0);
+        } else {
+            MockTiming::setMicros(next);
+        }
+        simLoop();
+    }
+}
+
+// Send one command line and return everything the firmware printed in reply
+inline std::string simCommand(const char* line) {
+    MockSerial.clearOutput();
+    MockSerial.setInput(line);
+    MockSerial.setInput("\n");
+    simDrainInput();
+    return MockSerial.getOutput();
+}
+
+// The four display digits as text ("12:34"; blank digits are spaces, '?' unknown)
+inline std::string simDisplayText() {
+    static const uint8_t digits[] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F};
+    std::string text;
+    for (uint8_t i = 0; i < 4; i++) {
+        uint8_t seg = display.segments[i] & 0x7F;
+        char c = seg == 0 ? ' ' : '?';
+        for (uint8_t d = 0; d < 10; d++) {
+            if (digits[d] == seg) c = '0' + d;
+        }
+        text += c;
+        if (i == 1) text += (display.segments[1] & 0x80) ? ':' : ' ';
+    }
+    return text;
+}
@@ -1,32 +1,49 @@
 #pragma once
+#include <stdint.h>
 
-// Mock timing functions for testable time-dependent code
+// Mock timing functions for testable time-dependent code.
+// Virtual time in microseconds; millis()/micros() truncate to 32 bits like the AVR.
 class MockTiming {
 private:
-    static unsigned long mockMillis;
+    static inline uint64_t mockMicros = 0;
 
 public:
     // Get the mocked value of millis()
-    static unsigned long millis() {
-        return mockMillis;
+    static uint32_t millis() {
+        return (uint32_t)(mockMicros / 1000);
+    }
+
+    static uint32_t micros() {
+        return (uint32_t)mockMicros;
+    }
+
+    // Full 64-bit virtual time (does not wrap)
+    static uint64_t nowMicros() {
+        return mockMicros;
     }
 
     // Set mock time for testing
     static void setMillis(unsigned long ms) {
-        mockMillis = ms;
+        mockMicros = (uint64_t)ms * 1000;
+    }
+
+    static void setMicros(uint64_t us) {
+        mockMicros = us;
     }
 
     // Advance mock time
     static void advanceMillis(unsigned long ms) {
-        mockMillis += ms;
+        mockMicros += (uint64_t)ms * 1000;
+    }
+
+    static void advanceMicros(uint64_t us) {
+        mockMicros += us;
     }
 
     // Reset to 0
     static void reset() {
-        mockMillis = 0;
+        mockMicros = 0;
     }
 };
 
-unsigned long MockTiming::mockMillis = 0;
-
-// In tests, replace ::millis() with MockTiming::millis()
+// In tests, replace ::millis() with MockTiming::millis() (MockArduino.h does this)
@@ -1,5 +1,6 @@
 #include "unity.h"
 #include "datetime.h"
+#include "dst_table.h"
 
 // ============================================================================
 // TEST: Day of Week Calculations (Zeller's Congruence)
@@ -22,8 +23,8 @@ void test_getDayOfWeek_knownDates(void) {
 
 void test_getDayOfWeek_sundays(void) {
   // Verify that known Sundays return 0
-  // March 2, 2026 is a Sunday (0)
-  TEST_ASSERT_EQUAL(0, getDayOfWeek(2026, 3, 2));
+  // March 1, 2026 is a Sunday (0)
+  TEST_ASSERT_EQUAL(0, getDayOfWeek(2026, 3, 1));
   
   // October 4, 2026 is a Sunday (0)
   TEST_ASSERT_EQUAL(0, getDayOfWeek(2026, 10, 4));
@@ -31,7 +32,7 @@ void test_getDayOfWeek_sundays(void) {
 
 void test_getDayOfWeek_leapYears(void) {
   // Leap year: 2020
-  TEST_ASSERT_EQUAL(0, getDayOfWeek(2020, 2, 29));  // Sunday
+  TEST_ASSERT_EQUAL(6, getDayOfWeek(2020, 2, 29));  // Saturday
   
   // Non-leap year: 2021
   // February 28, 2021 is Sunday (0)
@@ -83,6 +84,22 @@ void test_getNthSunday_lastSunday(void) {
   TEST_ASSERT_EQUAL(22, getNthSunday(2026, 2, -1));
 }
 
+void test_getNthWeekday_otherWeekdays(void) {
+  // March 2026 starts on a Sunday: 1st Monday is March 2, 2nd Saturday March 14
+  TEST_ASSERT_EQUAL(2, getNthWeekday(2026, 3, 1, 1));
+  TEST_ASSERT_EQUAL(14, getNthWeekday(2026, 3, 6, 2));
+  
+  // Last Friday of October 2026 is October 30, last Saturday is the 31st itself
+  TEST_ASSERT_EQUAL(30, getNthWeekday(2026, 10, 5, -1));
+  TEST_ASSERT_EQUAL(31, getNthWeekday(2026, 10, 6, -1));
+  
+  // Every weekday, first and last, agrees with getDayOfWeek
+  for (uint8_t weekday = 0; weekday < 7; weekday++) {
+    TEST_ASSERT_EQUAL(weekday, getDayOfWeek(2027, 2, getNthWeekday(2027, 2, weekday, 1)));
+    TEST_ASSERT_EQUAL(weekday, getDayOfWeek(2027, 2, getNthWeekday(2027, 2, weekday, -1)));
+  }
+}
+
 // ============================================================================
 // TEST: format12Hour Conversion
 // ============================================================================
@@ -313,6 +330,192 @@ void test_isDSTActive_Brazil_winter(void) {
   TEST_ASSERT_FALSE(isDSTActive_Brazil(2026, 9, 30));
 }
 
+// ============================================================================
+// TEST: Epoch-Day Core
+// ============================================================================
+
+void test_daysFromCivil_knownDates(void) {
+  TEST_ASSERT_EQUAL_INT32(0, daysFromCivil(1970, 1, 1));
+  TEST_ASSERT_EQUAL_INT32(10957, daysFromCivil(2000, 1, 1));
+  TEST_ASSERT_EQUAL_INT32(20454, daysFromCivil(2026, 1, 1));
+  TEST_ASSERT_EQUAL_INT32(-1, daysFromCivil(1969, 12, 31));
+}
+
+void test_civilFromDays_roundTrip(void) {
+  // Every day from 2000 through 2099 maps back to itself
+  int32_t first = daysFromCivil(2000, 1, 1);
+  int32_t last = daysFromCivil(2099, 12, 31);
+  for (int32_t d = first; d <= last; d++) {
+    uint16_t y;
+    uint8_t m, day;
+    civilFromDays(d, y, m, day);
+    TEST_ASSERT_EQUAL_INT32(d, daysFromCivil(y, m, day));
+  }
+  
+  uint16_t y;
+  uint8_t m, day;
+  civilFromDays(daysFromCivil(2028, 2, 28) + 1, y, m, day);
+  TEST_ASSERT_EQUAL(2028, y);
+  TEST_ASSERT_EQUAL(2, m);
+  TEST_ASSERT_EQUAL(29, day);
+}
+
+void test_getDaysInMonth(void) {
+  TEST_ASSERT_EQUAL(31, getDaysInMonth(2026, 1));
+  TEST_ASSERT_EQUAL(28, getDaysInMonth(2026, 2));
+  TEST_ASSERT_EQUAL(29, getDaysInMonth(2028, 2));
+  TEST_ASSERT_EQUAL(28, getDaysInMonth(2100, 2));
+  TEST_ASSERT_EQUAL(29, getDaysInMonth(2000, 2));
+  TEST_ASSERT_EQUAL(30, getDaysInMonth(2026, 11));
+}
+
+void test_addMinutes_carriesDate(void) {
+  uint16_t y;
+  uint8_t m, d, h, mi;
+  
+  // Local 23:30 Dec 31 in UTC+1 is 22:30 UTC the same day
+  y = 2026; m = 12; d = 31; h = 23; mi = 30;
+  addMinutes(y, m, d, h, mi, -60);
+  TEST_ASSERT_EQUAL(2026, y); TEST_ASSERT_EQUAL(12, m); TEST_ASSERT_EQUAL(31, d);
+  TEST_ASSERT_EQUAL(22, h); TEST_ASSERT_EQUAL(30, mi);
+  
+  // Local 21:00 Dec 31 in USA Eastern (-5) is 02:00 UTC on Jan 1 of the next year
+  y = 2026; m = 12; d = 31; h = 21; mi = 0;
+  addMinutes(y, m, d, h, mi, 300);
+  TEST_ASSERT_EQUAL(2027, y); TEST_ASSERT_EQUAL(1, m); TEST_ASSERT_EQUAL(1, d);
+  TEST_ASSERT_EQUAL(2, h); TEST_ASSERT_EQUAL(0, mi);
+  
+  // 02:00 UTC Mar 1 2028 is Feb 29 local in USA Eastern (leap year)
+  y = 2028; m = 3; d = 1; h = 2; mi = 0;
+  addMinutes(y, m, d, h, mi, -300);
+  TEST_ASSERT_EQUAL(2028, y); TEST_ASSERT_EQUAL(2, m); TEST_ASSERT_EQUAL(29, d);
+  TEST_ASSERT_EQUAL(21, h); TEST_ASSERT_EQUAL(0, mi);
+}
+
+// ============================================================================
+// TEST: Day/Seconds of Year
+// ============================================================================
+
+void test_getDayOfYear(void) {
+  TEST_ASSERT_EQUAL(0, getDayOfYear(2026, 1, 1));
+  TEST_ASSERT_EQUAL(66, getDayOfYear(2026, 3, 8));
+  TEST_ASSERT_EQUAL(364, getDayOfYear(2026, 12, 31));
+  
+  // Leap year: days after February shift by one
+  TEST_ASSERT_EQUAL(59, getDayOfYear(2028, 2, 29));
+  TEST_ASSERT_EQUAL(365, getDayOfYear(2028, 12, 31));
+}
+
+void test_getSecondsOfYear(void) {
+  TEST_ASSERT_EQUAL_UINT32(0, getSecondsOfYear(2026, 1, 1, 0, 0, 0));
+  TEST_ASSERT_EQUAL_UINT32(86399UL, getSecondsOfYear(2026, 1, 1, 23, 59, 59));
+  TEST_ASSERT_EQUAL_UINT32(66UL * 86400UL + 7UL * 3600UL, getSecondsOfYear(2026, 3, 8, 7, 0, 0));
+}
+
+// ============================================================================
+// TEST: DST Transition Instants (UTC seconds of year)
+// ============================================================================
+
+static uint32_t utcSeconds(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute) {
+  return getSecondsOfYear(year, month, day, hour, minute, 0);
+}
+
+void test_getDSTTransitions_none(void) {
+  uint32_t start, end;
+  TEST_ASSERT_FALSE(getDSTTransitions(DST_RULE_NONE, 2026, 0, start, end));
+}
+
+void test_getDSTTransitions_USA_Eastern(void) {
+  // 2026: Mar 8 02:00 EST = 07:00 UTC, Nov 1 02:00 EDT = 06:00 UTC
+  uint32_t start, end;
+  TEST_ASSERT_TRUE(getDSTTransitions(DST_RULE_USA_CANADA, 2026, -300, start, end));
+  TEST_ASSERT_EQUAL_UINT32(utcSeconds(2026, 3, 8, 7, 0), start);
+  TEST_ASSERT_EQUAL_UINT32(utcSeconds(2026, 11, 1, 6, 0), end);
+}
+
+void test_getDSTTransitions_UK_EU(void) {
+  // 01:00 UTC for every EU zone: 2026 Mar 29 and Oct 25
+  uint32_t start, end;
+  TEST_ASSERT_TRUE(getDSTTransitions(DST_RULE_UK_EU, 2026, 60, start, end));
+  TEST_ASSERT_EQUAL_UINT32(utcSeconds(2026, 3, 29, 1, 0), start);
+  TEST_ASSERT_EQUAL_UINT32(utcSeconds(2026, 10, 25, 1, 0), end);
+}
+
+void test_getDSTTransitions_Australia(void) {
+  // Sydney (UTC+10) 2026: Apr 5 03:00 AEDT = Apr 4 16:00 UTC, Oct 4 02:00 AEST = Oct 3 16:00 UTC
+  uint32_t start, end;
+  TEST_ASSERT_TRUE(getDSTTransitions(DST_RULE_AUSTRALIA, 2026, 600, start, end));
+  TEST_ASSERT_EQUAL_UINT32(utcSeconds(2026, 10, 3, 16, 0), start);
+  TEST_ASSERT_EQUAL_UINT32(utcSeconds(2026, 4, 4, 16, 0), end);
+}
+
+void test_getDSTTransitions_NewZealand(void) {
+  // UTC+12 2026: Apr 5 03:00 NZDT = Apr 4 14:00 UTC, Sep 27 02:00 NZST = Sep 26 14:00 UTC
+  uint32_t start, end;
+  TEST_ASSERT_TRUE(getDSTTransitions(DST_RULE_NEW_ZEALAND, 2026, 720, start, end));
+  TEST_ASSERT_EQUAL_UINT32(utcSeconds(2026, 9, 26, 14, 0), start);
+  TEST_ASSERT_EQUAL_UINT32(utcSeconds(2026, 4, 4, 14, 0), end);
+}
+
+void test_getDSTTransitions_halfHourOffset(void) {
+  // Adelaide (UTC+9:30) 2026: Apr 5 03:00 ACDT = Apr 4 16:30 UTC, Oct 4 02:00 ACST = Oct 3 16:30 UTC
+  uint32_t start, end;
+  TEST_ASSERT_TRUE(getDSTTransitions(DST_RULE_AUSTRALIA, 2026, 570, start, end));
+  TEST_ASSERT_EQUAL_UINT32(utcSeconds(2026, 10, 3, 16, 30), start);
+  TEST_ASSERT_EQUAL_UINT32(utcSeconds(2026, 4, 4, 16, 30), end);
+}
+
+void test_isDSTActiveOnDate_descriptor(void) {
+  // A rule no built-in zone uses: last Friday of March to the 4th Saturday of October
+  const DSTRule rule = {{3, -1, 5, DST_AT_WALL, 120}, {10, 4, 6, DST_AT_STANDARD, 60}, 30};
+  TEST_ASSERT_FALSE(isDSTActiveOnDate(rule, 2026, 3, 26));
+  TEST_ASSERT_TRUE(isDSTActiveOnDate(rule, 2026, 3, 27));   // Last Friday
+  TEST_ASSERT_TRUE(isDSTActiveOnDate(rule, 2026, 10, 23));
+  TEST_ASSERT_FALSE(isDSTActiveOnDate(rule, 2026, 10, 24));  // 4th Saturday
+  TEST_ASSERT_EQUAL(getDayOfYear(2026, 3, 27), getDSTSwitchDay(rule.start, 2026));
+}
+
+// ============================================================================
+// TEST: Compile-Time DST Table
+// ============================================================================
+
+typedef bool (*DSTActiveFn)(uint16_t year, uint8_t month, uint8_t day);
+
+void test_dstTable_matchesAlgorithms(void) {
+  // Indexed by rule - 1, same order as the table
+  const DSTActiveFn algorithms[DST_TABLE_RULES] = {
+    isDSTActive_USA_Canada, isDSTActive_UK, isDSTActive_Australia,
+    isDSTActive_NewZealand, isDSTActive_Brazil
+  };
+  
+  // Every day of every table year: the date-level DST state derived from the
+  // table's transition days must equal the runtime algorithm
+  for (uint8_t rule = 1; rule <= DST_TABLE_RULES; rule++) {
+    for (uint16_t year = DST_TABLE_FIRST_YEAR; year <= DST_TABLE_LAST_YEAR; year++) {
+      uint16_t startDay, endDay;
+      TEST_ASSERT_TRUE(getDSTTransitionDays(rule, year, startDay, endDay));
+      for (uint8_t month = 1; month <= 12; month++) {
+        for (uint8_t day = 1; day <= getDaysInMonth(year, month); day++) {
+          uint16_t doy = getDayOfYear(year, month, day);
+          bool fromTable = startDay < endDay ? (doy >= startDay && doy < endDay)
+                                             : (doy >= startDay || doy < endDay);
+          TEST_ASSERT_EQUAL(algorithms[rule - 1](year, month, day), fromTable);
+        }
+      }
+    }
+  }
+}
+
+void test_dstTable_fallbackOutsideRange(void) {
+  // 2036 is past the table: computed at run time, same answer as the algorithm
+  uint16_t startDay, endDay;
+  TEST_ASSERT_TRUE(getDSTTransitionDays(DST_RULE_USA_CANADA, 2036, startDay, endDay));
+  TEST_ASSERT_EQUAL(getDayOfYear(2036, 3, getNthSunday(2036, 3, 2)), startDay);
+  TEST_ASSERT_EQUAL(getDayOfYear(2036, 11, getNthSunday(2036, 11, 1)), endDay);
+  
+  TEST_ASSERT_FALSE(getDSTTransitionDays(DST_RULE_NONE, 2026, startDay, endDay));
+}
+
 // ============================================================================
 // MAIN TEST RUNNER
 // ============================================================================
@@ -325,7 +528,7 @@ void tearDown(void) {
   // Run after each test
 }
 
-void main(void) {
+int main(void) {
   UNITY_BEGIN();
   
   // Day of week tests
@@ -338,6 +541,7 @@ void main(void) {
   RUN_TEST(test_getNthSunday_secondSunday);
   RUN_TEST(test_getNthSunday_thirdSunday);
   RUN_TEST(test_getNthSunday_lastSunday);
+  RUN_TEST(test_getNthWeekday_otherWeekdays);
   
   // 12-hour format tests
   RUN_TEST(test_format12Hour_midnight);
@@ -377,5 +581,28 @@ void main(void) {
   RUN_TEST(test_isDSTActive_Brazil_februaryTransition);
   RUN_TEST(test_isDSTActive_Brazil_winter);
   
-  UNITY_END();
+  // Epoch-day core tests
+  RUN_TEST(test_daysFromCivil_knownDates);
+  RUN_TEST(test_civilFromDays_roundTrip);
+  RUN_TEST(test_getDaysInMonth);
+  RUN_TEST(test_addMinutes_carriesDate);
+  
+  // Compile-time DST table tests
+  RUN_TEST(test_dstTable_matchesAlgorithms);
+  RUN_TEST(test_dstTable_fallbackOutsideRange);
+  
+  // Day/seconds of year tests
+  RUN_TEST(test_getDayOfYear);
+  RUN_TEST(test_getSecondsOfYear);
+  
+  // DST transition instant tests
+  RUN_TEST(test_getDSTTransitions_none);
+  RUN_TEST(test_getDSTTransitions_USA_Eastern);
+  RUN_TEST(test_getDSTTransitions_UK_EU);
+  RUN_TEST(test_getDSTTransitions_Australia);
+  RUN_TEST(test_getDSTTransitions_NewZealand);
+  RUN_TEST(test_getDSTTransitions_halfHourOffset);
+  RUN_TEST(test_isDSTActiveOnDate_descriptor);
+  
+  return UNITY_END();
 }
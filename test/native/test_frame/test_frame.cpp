@@ -0,0 +1,204 @@
+#include "unity.h"
+#include <string.h>
+#include "frame.h"
+#include "command.h"
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static FrameReceiver rx;
+
+// A (sync all) body: 3/15/2026 12:34:56, 12h, EU Central, brightness 5,
+// schedule on 22:30@1 - 07:00@5
+static const uint8_t syncBody[] = {
+  CMD_SYNC_ALL, 3, 15, 2026 >> 8, 2026 & 0xFF, 12, 34, 56, 1, 14, 5, 1, 22, 30, 1, 7, 0, 5
+};
+
+// Feed a whole buffer; returns the result of the last byte
+static uint8_t feedAll(const uint8_t* data, uint8_t len, uint32_t nowMs) {
+  uint8_t result = FRAME_PENDING;
+  for (uint8_t i = 0; i < len; i++) {
+    result = frameFeed(rx, data[i], nowMs);
+  }
+  return result;
+}
+
+// ============================================================================
+// TEST: Encode / Receive
+// ============================================================================
+
+void test_frame_roundTrip(void) {
+  uint8_t frame[FRAME_MAX_SIZE];
+  uint8_t size = frameEncode(frame, syncBody, sizeof(syncBody));
+  TEST_ASSERT_EQUAL(sizeof(syncBody) + FRAME_OVERHEAD, size);
+  TEST_ASSERT_EQUAL_HEX8(FRAME_SYNC, frame[0]);
+  TEST_ASSERT_EQUAL(sizeof(syncBody), frame[1]);
+
+  TEST_ASSERT_EQUAL(FRAME_READY, feedAll(frame, size, 0));
+  TEST_ASSERT_EQUAL(sizeof(syncBody), rx.len);
+  TEST_ASSERT_EQUAL_MEMORY(syncBody, rx.body, sizeof(syncBody));
+  TEST_ASSERT_FALSE(frameActive(rx, 0));
+}
+
+void test_frame_syncAllDecodes(void) {
+  Command cmd;
+  TEST_ASSERT_EQUAL(PARSE_OK, decodeCommand(syncBody, sizeof(syncBody), cmd));
+  TEST_ASSERT_EQUAL(CMD_SYNC_ALL, cmd.op);
+  TEST_ASSERT_EQUAL(2026, cmd.args[SYNC_YEAR]);
+  TEST_ASSERT_EQUAL(56, cmd.args[SYNC_SECOND]);
+  TEST_ASSERT_EQUAL(5, cmd.args[SYNC_BRIGHT_LEVEL]);
+}
+
+void test_frame_syncIsFourTimesSmallerThanText(void) {
+  // The text A line and syncBody must be the same command
+  const char* text = "A3,15,2026,12,34,56,1,14,5,1,22,30,1,7,0,5";
+  Command fromText, fromFrame;
+  TEST_ASSERT_EQUAL(PARSE_OK, parseCommand(text, fromText));
+  TEST_ASSERT_EQUAL(PARSE_OK, decodeCommand(syncBody, sizeof(syncBody), fromFrame));
+  TEST_ASSERT_EQUAL(fromText.argc, fromFrame.argc);
+  TEST_ASSERT_EQUAL_MEMORY(fromText.args, fromFrame.args, fromText.argc * sizeof(int16_t));
+
+  // Request and reply on the wire. Text: the line, the DBG:RX echo and OK:A.
+  // Frames: the request and a reply with status and the DST flag.
+  const char* textReply =
+    "DBG:RX A3,15,2026,12,34,56,1,14,5,1,22,30,1,7,0,5\r\n"
+    "OK:A date=3/15/2026,time=12:34:56,dst=0,f=1,z=14,b=5,enabled=1,dim=22:30:1,bright=07:00:5\r\n";
+  uint8_t request[FRAME_MAX_SIZE];
+  uint8_t reply[FRAME_MAX_SIZE];
+  const uint8_t replyBody[] = {CMD_SYNC_ALL | FRAME_REPLY, PARSE_OK, 0};
+  uint8_t frameBytes = frameEncode(request, syncBody, sizeof(syncBody)) +
+                       frameEncode(reply, replyBody, sizeof(replyBody));
+  size_t textBytes = strlen(text) + 1 + strlen(textReply);
+  TEST_ASSERT_EQUAL(29, frameBytes);
+  TEST_ASSERT_TRUE(textBytes >= 4 * frameBytes);
+}
+
+// ============================================================================
+// TEST: Corruption
+// ============================================================================
+
+void test_frame_everySingleBitFlipIsRejected(void) {
+  uint8_t frame[FRAME_MAX_SIZE];
+  uint8_t size = frameEncode(frame, syncBody, sizeof(syncBody));
+
+  // Flip each bit after SYNC; the frame must never be accepted
+  for (uint8_t i = 1; i < size; i++) {
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      uint8_t corrupt[FRAME_MAX_SIZE];
+      memcpy(corrupt, frame, size);
+      corrupt[i] ^= 1 << bit;
+
+      frameReset(rx);
+      uint32_t now = (uint32_t)i * 8 + bit;
+      bool accepted = false;
+      for (uint8_t j = 0; j < size; j++) {
+        if (frameFeed(rx, corrupt[j], now) == FRAME_READY) accepted = true;
+      }
+      TEST_ASSERT_FALSE(accepted);
+    }
+  }
+}
+
+void test_frame_badCrcReported(void) {
+  uint8_t frame[FRAME_MAX_SIZE];
+  uint8_t size = frameEncode(frame, syncBody, sizeof(syncBody));
+  frame[size - 1] ^= 0xFF;
+  TEST_ASSERT_EQUAL(FRAME_BAD_CRC, feedAll(frame, size, 0));
+
+  // LEN may have been the corrupt byte: later bytes are swallowed until a gap
+  const uint8_t tail[] = {'j', 'Q', '\n'};
+  TEST_ASSERT_EQUAL(FRAME_PENDING, feedAll(tail, sizeof(tail), 10));
+  TEST_ASSERT_TRUE(frameActive(rx, 10));
+  TEST_ASSERT_FALSE(frameActive(rx, 10 + FRAME_TIMEOUT_MS + 1));
+}
+
+void test_frame_badLengthDiscardsUntilQuiet(void) {
+  const uint8_t bad[] = {FRAME_SYNC, FRAME_MAX_BODY + 1};
+  TEST_ASSERT_EQUAL(FRAME_BAD_LENGTH, feedAll(bad, sizeof(bad), 0));
+
+  // The rest of the frame is swallowed, whatever it contains
+  const uint8_t rest[] = {'B', '5', '\n'};
+  TEST_ASSERT_EQUAL(FRAME_PENDING, feedAll(rest, sizeof(rest), 10));
+  TEST_ASSERT_TRUE(frameActive(rx, 10));
+
+  // Quiet line: idle again
+  TEST_ASSERT_FALSE(frameActive(rx, 10 + FRAME_TIMEOUT_MS + 1));
+}
+
+void test_frame_stalledFrameIsDropped(void) {
+  uint8_t frame[FRAME_MAX_SIZE];
+  uint8_t size = frameEncode(frame, syncBody, sizeof(syncBody));
+
+  // First half, then silence, then a complete frame
+  feedAll(frame, size / 2, 0);
+  TEST_ASSERT_TRUE(frameActive(rx, 0));
+  TEST_ASSERT_EQUAL(FRAME_READY, feedAll(frame, size, FRAME_TIMEOUT_MS + 1));
+}
+
+// ============================================================================
+// TEST: Binary Command Decoding
+// ============================================================================
+
+void test_frame_decodeChecksRanges(void) {
+  Command cmd;
+
+  // B8: out of range, same as the text command
+  const uint8_t badBrightness[] = {CMD_BRIGHTNESS, 8};
+  TEST_ASSERT_EQUAL(PARSE_BAD_ARGS, decodeCommand(badBrightness, sizeof(badBrightness), cmd));
+  TEST_ASSERT_EQUAL(CMD_BRIGHTNESS, cmd.op);
+
+  // D2,30,2026: no such day
+  const uint8_t badDate[] = {CMD_DATE, 2, 30, 2026 >> 8, 2026 & 0xFF};
+  TEST_ASSERT_EQUAL(PARSE_BAD_ARGS, decodeCommand(badDate, sizeof(badDate), cmd));
+
+  // D1,1,65535: a high byte with bit 7 set is still just a large year
+  const uint8_t hugeYear[] = {CMD_DATE, 1, 1, 0xFF, 0xFF};
+  TEST_ASSERT_EQUAL(PARSE_BAD_ARGS, decodeCommand(hugeYear, sizeof(hugeYear), cmd));
+
+  // Wrong body size for the opcode
+  TEST_ASSERT_EQUAL(PARSE_BAD_ARGS, decodeCommand(syncBody, sizeof(syncBody) - 1, cmd));
+  const uint8_t longQuery[] = {CMD_QUERY_FORMAT, 0};
+  TEST_ASSERT_EQUAL(PARSE_BAD_ARGS, decodeCommand(longQuery, sizeof(longQuery), cmd));
+
+  // Unknown opcode
+  const uint8_t unknown[] = {0x7F};
+  TEST_ASSERT_EQUAL(PARSE_UNKNOWN, decodeCommand(unknown, sizeof(unknown), cmd));
+
+  // Handshake
+  const uint8_t handshake[] = {CMD_HANDSHAKE};
+  TEST_ASSERT_EQUAL(PARSE_OK, decodeCommand(handshake, sizeof(handshake), cmd));
+  TEST_ASSERT_EQUAL(CMD_HANDSHAKE, cmd.op);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void setUp(void) {
+  frameReset(rx);
+}
+
+void tearDown(void) {
+  // Run after each test
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  // Encode / receive tests
+  RUN_TEST(test_frame_roundTrip);
+  RUN_TEST(test_frame_syncAllDecodes);
+  RUN_TEST(test_frame_syncIsFourTimesSmallerThanText);
+
+  // Corruption tests
+  RUN_TEST(test_frame_everySingleBitFlipIsRejected);
+  RUN_TEST(test_frame_badCrcReported);
+  RUN_TEST(test_frame_badLengthDiscardsUntilQuiet);
+  RUN_TEST(test_frame_stalledFrameIsDropped);
+
+  // Decoding tests
+  RUN_TEST(test_frame_decodeChecksRanges);
+
+  return UNITY_END();
+}
@@ -0,0 +1,528 @@
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+#include "command.h"
+
+// ============================================================================
+// HELPER FUNCTIONS FOR TESTING SERIAL PARSING
+// ============================================================================
+
+// Parse a line that must succeed with the given opcode
+static Command parseOk(const char* line, uint8_t op) {
+  Command cmd;
+  TEST_ASSERT_EQUAL(PARSE_OK, parseCommand(line, cmd));
+  TEST_ASSERT_EQUAL(op, cmd.op);
+  return cmd;
+}
+
+// Parse a line that names a known command but has bad arguments
+static void parseBadArgs(const char* line, uint8_t op) {
+  Command cmd;
+  TEST_ASSERT_EQUAL(PARSE_BAD_ARGS, parseCommand(line, cmd));
+  TEST_ASSERT_EQUAL(op, cmd.op);
+}
+
+// Parse a line that is not a command at all
+static void parseUnknown(const char* line) {
+  Command cmd;
+  TEST_ASSERT_EQUAL(PARSE_UNKNOWN, parseCommand(line, cmd));
+}
+
+// ============================================================================
+// TEST: Time Command Parsing (T<h>,<m>,<s>)
+// ============================================================================
+
+void test_parseTime_validTimes(void) {
+  Command cmd;
+
+  // Valid time: 12:34:56
+  cmd = parseOk("T12,34,56", CMD_TIME);
+  TEST_ASSERT_EQUAL(3, cmd.argc);
+  TEST_ASSERT_EQUAL(12, cmd.args[0]);
+  TEST_ASSERT_EQUAL(34, cmd.args[1]);
+  TEST_ASSERT_EQUAL(56, cmd.args[2]);
+
+  // Midnight: 00:00:00
+  cmd = parseOk("T0,0,0", CMD_TIME);
+  TEST_ASSERT_EQUAL(0, cmd.args[0]);
+  TEST_ASSERT_EQUAL(0, cmd.args[1]);
+  TEST_ASSERT_EQUAL(0, cmd.args[2]);
+
+  // End of day: 23:59:59
+  cmd = parseOk("T23,59,59", CMD_TIME);
+  TEST_ASSERT_EQUAL(23, cmd.args[0]);
+  TEST_ASSERT_EQUAL(59, cmd.args[1]);
+  TEST_ASSERT_EQUAL(59, cmd.args[2]);
+}
+
+void test_parseTime_invalidHours(void) {
+  // Hour > 23
+  parseBadArgs("T24,0,0", CMD_TIME);
+
+  // Negative hour
+  parseBadArgs("T-1,0,0", CMD_TIME);
+}
+
+void test_parseTime_invalidMinutes(void) {
+  // Minutes > 59
+  parseBadArgs("T12,60,30", CMD_TIME);
+
+  // Negative minutes
+  parseBadArgs("T12,-1,30", CMD_TIME);
+}
+
+void test_parseTime_invalidSeconds(void) {
+  // Seconds > 59
+  parseBadArgs("T12,30,60", CMD_TIME);
+
+  // Negative seconds
+  parseBadArgs("T12,30,-1", CMD_TIME);
+}
+
+void test_parseTime_malformedInput(void) {
+  // Wrong prefix
+  parseUnknown("X12,34,56");
+
+  // Missing separator
+  parseBadArgs("T123456", CMD_TIME);
+
+  // Wrong number of args
+  parseBadArgs("T12,34", CMD_TIME);
+  parseBadArgs("T12,34,56,7", CMD_TIME);
+
+  // Trailing garbage
+  parseBadArgs("T12,34,56x", CMD_TIME);
+
+  // No digits
+  parseBadArgs("T,,", CMD_TIME);
+  parseBadArgs("T-,1,2", CMD_TIME);
+
+  // Empty string
+  parseUnknown("");
+
+  // Null pointer
+  parseUnknown(NULL);
+}
+
+// ============================================================================
+// TEST: Date Command Parsing (D<m>,<d>,<y>)
+// ============================================================================
+
+void test_parseDate_validDates(void) {
+  Command cmd;
+
+  // Valid date: March 15, 2026
+  cmd = parseOk("D3,15,2026", CMD_DATE);
+  TEST_ASSERT_EQUAL(3, cmd.args[0]);
+  TEST_ASSERT_EQUAL(15, cmd.args[1]);
+  TEST_ASSERT_EQUAL(2026, cmd.args[2]);
+
+  // First supported day: January 1, 2000
+  cmd = parseOk("D1,1,2000", CMD_DATE);
+  TEST_ASSERT_EQUAL(1, cmd.args[0]);
+  TEST_ASSERT_EQUAL(1, cmd.args[1]);
+  TEST_ASSERT_EQUAL(2000, cmd.args[2]);
+
+  // Last supported day: December 31, 2099
+  cmd = parseOk("D12,31,2099", CMD_DATE);
+  TEST_ASSERT_EQUAL(12, cmd.args[0]);
+  TEST_ASSERT_EQUAL(31, cmd.args[1]);
+  TEST_ASSERT_EQUAL(2099, cmd.args[2]);
+}
+
+void test_parseDate_invalidMonths(void) {
+  // Month > 12
+  parseBadArgs("D13,1,2026", CMD_DATE);
+
+  // Month < 1
+  parseBadArgs("D0,1,2026", CMD_DATE);
+}
+
+void test_parseDate_invalidDays(void) {
+  // Day > 31
+  parseBadArgs("D3,32,2026", CMD_DATE);
+
+  // Day < 1
+  parseBadArgs("D3,0,2026", CMD_DATE);
+
+  // Day past the end of the month
+  parseBadArgs("D4,31,2026", CMD_DATE);
+  parseBadArgs("D2,29,2026", CMD_DATE);
+  parseOk("D2,29,2028", CMD_DATE);  // Leap year
+}
+
+void test_parseDate_invalidYears(void) {
+  // Year < 2000
+  parseBadArgs("D3,15,1999", CMD_DATE);
+
+  // Year > 2099
+  parseBadArgs("D3,15,2100", CMD_DATE);
+
+  // Does not fit in int16_t
+  parseBadArgs("D3,15,99999", CMD_DATE);
+}
+
+void test_parseDate_malformedInput(void) {
+  // Wrong prefix
+  parseUnknown("X3,15,2026");
+
+  // Missing separator
+  parseBadArgs("D31526", CMD_DATE);
+
+  // Empty string
+  parseUnknown("");
+}
+
+// ============================================================================
+// TEST: Brightness Command Parsing (B<0-7>)
+// ============================================================================
+
+void test_parseBrightness_validBrightness(void) {
+  // Min brightness
+  TEST_ASSERT_EQUAL(0, parseOk("B0", CMD_BRIGHTNESS).args[0]);
+
+  // Mid brightness
+  TEST_ASSERT_EQUAL(5, parseOk("B5", CMD_BRIGHTNESS).args[0]);
+
+  // Max brightness
+  TEST_ASSERT_EQUAL(7, parseOk("B7", CMD_BRIGHTNESS).args[0]);
+}
+
+void test_parseBrightness_invalidBrightness(void) {
+  // Brightness > 7
+  parseBadArgs("B8", CMD_BRIGHTNESS);
+
+  // Brightness < 0
+  parseBadArgs("B-1", CMD_BRIGHTNESS);
+
+  // Missing value
+  parseBadArgs("B", CMD_BRIGHTNESS);
+}
+
+void test_parseBrightness_malformedInput(void) {
+  // Wrong prefix
+  parseUnknown("X5");
+
+  // Empty string
+  parseUnknown("");
+}
+
+// ============================================================================
+// TEST: Timezone Command Parsing (Z<id>)
+// ============================================================================
+
+void test_parseTimezone_validTimezones(void) {
+  // UTC
+  TEST_ASSERT_EQUAL(0, parseOk("Z0", CMD_TIMEZONE).args[0]);
+
+  // USA Eastern
+  TEST_ASSERT_EQUAL(1, parseOk("Z1", CMD_TIMEZONE).args[0]);
+
+  // Max valid timezone
+  TEST_ASSERT_EQUAL(22, parseOk("Z22", CMD_TIMEZONE).args[0]);
+}
+
+void test_parseTimezone_invalidTimezones(void) {
+  // Timezone > 22
+  parseBadArgs("Z23", CMD_TIMEZONE);
+
+  // Negative timezone
+  parseBadArgs("Z-1", CMD_TIMEZONE);
+}
+
+void test_parseTimezone_malformedInput(void) {
+  // Wrong prefix
+  parseUnknown("X0");
+
+  // Empty string
+  parseUnknown("");
+}
+
+// ============================================================================
+// TEST: Format Command Parsing (F<0|1>)
+// ============================================================================
+
+void test_parseFormat_valid24Hour(void) {
+  // 24-hour format
+  TEST_ASSERT_EQUAL(0, parseOk("F0", CMD_FORMAT).args[0]);
+}
+
+void test_parseFormat_valid12Hour(void) {
+  // 12-hour format
+  TEST_ASSERT_EQUAL(1, parseOk("F1", CMD_FORMAT).args[0]);
+}
+
+void test_parseFormat_invalidFormat(void) {
+  // Invalid format value
+  parseBadArgs("F2", CMD_FORMAT);
+  parseBadArgs("F-1", CMD_FORMAT);
+}
+
+void test_parseFormat_malformedInput(void) {
+  // Wrong prefix
+  parseUnknown("X0");
+
+  // Empty string
+  parseUnknown("");
+}
+
+// ============================================================================
+// TEST: Schedule Commands (S, N, Y) and Queries
+// ============================================================================
+
+void test_parseSchedule_commands(void) {
+  Command cmd;
+
+  TEST_ASSERT_EQUAL(1, parseOk("S1", CMD_SCHEDULE).args[0]);
+  parseBadArgs("S2", CMD_SCHEDULE);
+
+  // Night: 22:30 at brightness 1
+  cmd = parseOk("N22,30,1", CMD_NIGHT);
+  TEST_ASSERT_EQUAL(22, cmd.args[0]);
+  TEST_ASSERT_EQUAL(30, cmd.args[1]);
+  TEST_ASSERT_EQUAL(1, cmd.args[2]);
+  parseBadArgs("N22,30,8", CMD_NIGHT);
+
+  // Day: 07:00 at brightness 5
+  cmd = parseOk("Y7,0,5", CMD_DAY);
+  TEST_ASSERT_EQUAL(7, cmd.args[0]);
+  TEST_ASSERT_EQUAL(0, cmd.args[1]);
+  TEST_ASSERT_EQUAL(5, cmd.args[2]);
+  parseBadArgs("Y24,0,5", CMD_DAY);
+
+  // Night blanking on/off
+  TEST_ASSERT_EQUAL(1, parseOk("K1", CMD_NIGHT_BLANK).args[0]);
+  parseBadArgs("K2", CMD_NIGHT_BLANK);
+}
+
+void test_parseQuery_commands(void) {
+  TEST_ASSERT_EQUAL(0, parseOk("QF", CMD_QUERY_FORMAT).argc);
+  parseOk("QS", CMD_QUERY_SCHEDULE);
+  parseOk("QT", CMD_QUERY_TICK);
+  parseOk("QD", CMD_QUERY_DISPLAY);
+
+  // Queries take no arguments
+  parseBadArgs("QF1", CMD_QUERY_FORMAT);
+
+  // Unknown query
+  parseUnknown("QX");
+  parseUnknown("Q");
+}
+
+// ============================================================================
+// TEST: Sync All Command (A)
+// ============================================================================
+
+void test_parseSyncAll_valid(void) {
+  // 3/15/2026 12:34:56, 12h, EU Central, brightness 5, schedule on 22:30@1 - 07:00@5
+  Command cmd = parseOk("A3,15,2026,12,34,56,1,14,5,1,22,30,1,7,0,5", CMD_SYNC_ALL);
+  TEST_ASSERT_EQUAL(CMD_SYNC_ALL_ARGS, cmd.argc);
+  TEST_ASSERT_EQUAL(3, cmd.args[SYNC_MONTH]);
+  TEST_ASSERT_EQUAL(15, cmd.args[SYNC_DAY]);
+  TEST_ASSERT_EQUAL(2026, cmd.args[SYNC_YEAR]);
+  TEST_ASSERT_EQUAL(12, cmd.args[SYNC_HOUR]);
+  TEST_ASSERT_EQUAL(34, cmd.args[SYNC_MINUTE]);
+  TEST_ASSERT_EQUAL(56, cmd.args[SYNC_SECOND]);
+  TEST_ASSERT_EQUAL(1, cmd.args[SYNC_FORMAT]);
+  TEST_ASSERT_EQUAL(14, cmd.args[SYNC_TZ]);
+  TEST_ASSERT_EQUAL(5, cmd.args[SYNC_BRIGHTNESS]);
+  TEST_ASSERT_EQUAL(1, cmd.args[SYNC_SCHEDULE]);
+  TEST_ASSERT_EQUAL(22, cmd.args[SYNC_DIM_HOUR]);
+  TEST_ASSERT_EQUAL(30, cmd.args[SYNC_DIM_MINUTE]);
+  TEST_ASSERT_EQUAL(1, cmd.args[SYNC_DIM_LEVEL]);
+  TEST_ASSERT_EQUAL(7, cmd.args[SYNC_BRIGHT_HOUR]);
+  TEST_ASSERT_EQUAL(0, cmd.args[SYNC_BRIGHT_MINUTE]);
+  TEST_ASSERT_EQUAL(5, cmd.args[SYNC_BRIGHT_LEVEL]);
+}
+
+void test_parseSyncAll_invalid(void) {
+  // Any single field out of range rejects the whole command
+  parseBadArgs("A2,30,2026,12,34,56,1,14,5,1,22,30,1,7,0,5", CMD_SYNC_ALL);  // Feb 30
+  parseBadArgs("A3,15,2026,24,34,56,1,14,5,1,22,30,1,7,0,5", CMD_SYNC_ALL);  // Hour
+  parseBadArgs("A3,15,2026,12,34,56,2,14,5,1,22,30,1,7,0,5", CMD_SYNC_ALL);  // Format
+  parseBadArgs("A3,15,2026,12,34,56,1,23,5,1,22,30,1,7,0,5", CMD_SYNC_ALL);  // Timezone
+  parseBadArgs("A3,15,2026,12,34,56,1,14,5,1,22,30,1,7,0,8", CMD_SYNC_ALL);  // Bright level
+
+  // Missing and extra fields
+  parseBadArgs("A3,15,2026,12,34,56,1,14,5,1,22,30,1,7,0", CMD_SYNC_ALL);
+  parseBadArgs("A3,15,2026,12,34,56,1,14,5,1,22,30,1,7,0,5,1", CMD_SYNC_ALL);
+}
+
+// ============================================================================
+// TEST: Link and Output Commands
+// ============================================================================
+
+void test_parseBaud_commands(void) {
+  Command cmd = parseOk("U1152", CMD_SET_BAUD);
+  TEST_ASSERT_EQUAL(1152, cmd.args[0]);
+  TEST_ASSERT_EQUAL_UINT32(115200, baudFromCode(cmd.args[0]));
+  TEST_ASSERT_EQUAL_UINT32(57600, baudFromCode(parseOk("U576", CMD_SET_BAUD).args[0]));
+  TEST_ASSERT_EQUAL_UINT32(9600, baudFromCode(parseOk("U96", CMD_SET_BAUD).args[0]));
+
+  // Only the standard rates
+  parseBadArgs("U1000", CMD_SET_BAUD);
+  parseBadArgs("U0", CMD_SET_BAUD);
+  parseBadArgs("U", CMD_SET_BAUD);
+  parseBadArgs("U1152,1", CMD_SET_BAUD);
+
+  parseOk("P", CMD_PING);
+  parseBadArgs("P1", CMD_PING);
+}
+
+void test_parseVerbosity_commands(void) {
+  TEST_ASSERT_EQUAL(VERBOSITY_SILENT, parseOk("V0", CMD_VERBOSITY).args[0]);
+  TEST_ASSERT_EQUAL(VERBOSITY_DEBUG, parseOk("V2", CMD_VERBOSITY).args[0]);
+  parseBadArgs("V3", CMD_VERBOSITY);
+  parseBadArgs("V", CMD_VERBOSITY);
+  parseOk("QV", CMD_QUERY_VERBOSITY);
+
+  // Silent still answers queries and link commands, not settings
+  TEST_ASSERT_TRUE(commandAlwaysReplies(CMD_QUERY_VERBOSITY));
+  TEST_ASSERT_TRUE(commandAlwaysReplies(CMD_PING));
+  TEST_ASSERT_TRUE(commandAlwaysReplies(CMD_VERBOSITY));
+  TEST_ASSERT_FALSE(commandAlwaysReplies(CMD_BRIGHTNESS));
+  TEST_ASSERT_FALSE(commandAlwaysReplies(CMD_NONE));
+}
+
+void test_parseCounters_commands(void) {
+  parseOk("QC", CMD_QUERY_COUNTERS);
+  parseOk("RC", CMD_RESET_COUNTERS);
+  parseUnknown("R");
+  TEST_ASSERT_TRUE(commandAlwaysReplies(CMD_QUERY_COUNTERS));
+  TEST_ASSERT_FALSE(commandAlwaysReplies(CMD_RESET_COUNTERS));
+}
+
+void test_parseTimeSet_commands(void) {
+  TEST_ASSERT_EQUAL(7, parseOk("J7", CMD_TIME_PROBE).args[0]);
+  parseBadArgs("J8", CMD_TIME_PROBE);
+
+  Command cmd = parseOk("W3,1250,3,15,2026,12,34,56", CMD_TIME_SET_AT);
+  TEST_ASSERT_EQUAL(3, cmd.args[TSET_SLOT]);
+  TEST_ASSERT_EQUAL(1250, cmd.args[TSET_DELAY_MS]);
+  TEST_ASSERT_EQUAL(2026, cmd.args[TSET_YEAR]);
+  TEST_ASSERT_EQUAL(56, cmd.args[TSET_SECOND]);
+  parseBadArgs("W3,10001,3,15,2026,12,34,56", CMD_TIME_SET_AT);  // Past TIME_SET_MAX_DELAY_MS
+  parseBadArgs("W3,1250,2,29,2026,12,34,56", CMD_TIME_SET_AT);   // Not a leap year
+
+  // Binary: the delay is two bytes like the year
+  const uint8_t body[] = {CMD_TIME_SET_AT, 3, 0x04, 0xE2, 3, 15, 0x07, 0xEA, 12, 34, 56};
+  TEST_ASSERT_EQUAL(PARSE_OK, decodeCommand(body, sizeof(body), cmd));
+  TEST_ASSERT_EQUAL(1250, cmd.args[TSET_DELAY_MS]);
+  TEST_ASSERT_TRUE(commandAlwaysReplies(CMD_TIME_SET_AT));
+}
+
+void test_parseAging_commands(void) {
+  TEST_ASSERT_EQUAL(-128, parseOk("G-128", CMD_AGING).args[0]);
+  TEST_ASSERT_EQUAL(80, parseOk("G80", CMD_AGING).args[0]);
+  parseBadArgs("G128", CMD_AGING);
+  parseOk("QG", CMD_QUERY_AGING);
+
+  // Binary: one signed byte
+  Command cmd;
+  const uint8_t body[] = {CMD_AGING, 0xF6};
+  TEST_ASSERT_EQUAL(PARSE_OK, decodeCommand(body, sizeof(body), cmd));
+  TEST_ASSERT_EQUAL(-10, cmd.args[0]);
+}
+
+// ============================================================================
+// TEST: Edge Cases and Buffer Handling
+// ============================================================================
+
+void test_parseTime_leadingZeros(void) {
+  // Time with leading zeros
+  Command cmd = parseOk("T01,02,03", CMD_TIME);
+  TEST_ASSERT_EQUAL(1, cmd.args[0]);
+  TEST_ASSERT_EQUAL(2, cmd.args[1]);
+  TEST_ASSERT_EQUAL(3, cmd.args[2]);
+}
+
+void test_parseDate_leadingZeros(void) {
+  // Date with leading zeros
+  Command cmd = parseOk("D03,05,2026", CMD_DATE);
+  TEST_ASSERT_EQUAL(3, cmd.args[0]);
+  TEST_ASSERT_EQUAL(5, cmd.args[1]);
+  TEST_ASSERT_EQUAL(2026, cmd.args[2]);
+}
+
+void test_parseTime_extraWhitespace(void) {
+  // Spaces after commas are accepted (as sscanf did)
+  Command cmd = parseOk("T12, 34, 56", CMD_TIME);
+  TEST_ASSERT_EQUAL(12, cmd.args[0]);
+  TEST_ASSERT_EQUAL(34, cmd.args[1]);
+  TEST_ASSERT_EQUAL(56, cmd.args[2]);
+}
+
+void test_parse_lineIsNotModified(void) {
+  // Zero-copy: the parser only reads the receive buffer
+  char line[] = "N22,30,1";
+  Command cmd;
+  TEST_ASSERT_EQUAL(PARSE_OK, parseCommand(line, cmd));
+  TEST_ASSERT_EQUAL_STRING("N22,30,1", line);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void setUp(void) {
+  // Run before each test
+}
+
+void tearDown(void) {
+  // Run after each test
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  // Time parsing tests
+  RUN_TEST(test_parseTime_validTimes);
+  RUN_TEST(test_parseTime_invalidHours);
+  RUN_TEST(test_parseTime_invalidMinutes);
+  RUN_TEST(test_parseTime_invalidSeconds);
+  RUN_TEST(test_parseTime_malformedInput);
+  RUN_TEST(test_parseTime_leadingZeros);
+  RUN_TEST(test_parseTime_extraWhitespace);
+
+  // Date parsing tests
+  RUN_TEST(test_parseDate_validDates);
+  RUN_TEST(test_parseDate_invalidMonths);
+  RUN_TEST(test_parseDate_invalidDays);
+  RUN_TEST(test_parseDate_invalidYears);
+  RUN_TEST(test_parseDate_malformedInput);
+  RUN_TEST(test_parseDate_leadingZeros);
+
+  // Brightness parsing tests
+  RUN_TEST(test_parseBrightness_validBrightness);
+  RUN_TEST(test_parseBrightness_invalidBrightness);
+  RUN_TEST(test_parseBrightness_malformedInput);
+
+  // Timezone parsing tests
+  RUN_TEST(test_parseTimezone_validTimezones);
+  RUN_TEST(test_parseTimezone_invalidTimezones);
+  RUN_TEST(test_parseTimezone_malformedInput);
+
+  // Format parsing tests
+  RUN_TEST(test_parseFormat_valid24Hour);
+  RUN_TEST(test_parseFormat_valid12Hour);
+  RUN_TEST(test_parseFormat_invalidFormat);
+  RUN_TEST(test_parseFormat_malformedInput);
+
+  // Schedule and query tests
+  RUN_TEST(test_parseSchedule_commands);
+  RUN_TEST(test_parseQuery_commands);
+  RUN_TEST(test_parse_lineIsNotModified);
+
+  // Sync all tests
+  RUN_TEST(test_parseSyncAll_valid);
+  RUN_TEST(test_parseSyncAll_invalid);
+
+  // Link and output commands
+  RUN_TEST(test_parseBaud_commands);
+  RUN_TEST(test_parseVerbosity_commands);
+  RUN_TEST(test_parseCounters_commands);
+  RUN_TEST(test_parseTimeSet_commands);
+  RUN_TEST(test_parseAging_commands);
+
+  return UNITY_END();
+}
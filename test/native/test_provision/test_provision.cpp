@@ -0,0 +1,262 @@
+#include "unity.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "Simulator.h"
+#include "provision.h"
+
+// Provisioning tool tests (tools/provision, see provision.h) against clocks on
+// pseudo-terminals. Each clock is a forked process running the firmware
+// simulator behind the master side of a pty; the tool opens the slave path
+// like a USB serial port. Simulated time follows the wall clock, and bytes take
+// their 9600 baud UART time, so timings are close to real hardware (minus USB
+// latency and the bootloader, which bootMs stands in for).
+
+#define UART_US_PER_BYTE 1042  // 10 bits at 9600 baud
+
+struct FakeClock {
+    pid_t pid;
+    int master;  // -1 when a child serves it
+    int slave;   // Held open so the master never sees a hangup
+    std::string path;
+};
+
+static std::vector<FakeClock> clocks;
+
+static uint64_t wallUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// Child: the firmware on the master side. Input is dropped for bootMs (the
+// bootloader), preset runs before the host connects (e.g. "V0").
+static void serveClock(int master, uint32_t bootMs, const char* preset) {
+    simBoot(MockDateTime(2020, 1, 1, 0, 0, 0));
+    if (preset) simCommand(preset);
+    MockSerial.clearOutput();
+
+    uint64_t startUs = wallUs();
+    uint64_t simStartUs = MockTiming::nowMicros();
+    for (;;) {
+        struct pollfd pfd = {master, POLLIN, 0};
+        poll(&pfd, 1, 2);
+        char buf[64];
+        ssize_t n = read(master, buf, sizeof(buf) - 1);
+        if (n < 0 && errno != EAGAIN && errno != EINTR) _exit(0);
+        if (n > 0) {
+            usleep(n * UART_US_PER_BYTE);
+            buf[n] = '\0';
+            if (wallUs() - startUs >= (uint64_t)bootMs * 1000) MockSerial.setInput(buf);
+        }
+
+        uint64_t target = simStartUs + (wallUs() - startUs);
+        if (target > MockTiming::nowMicros()) simRunMicros(target - MockTiming::nowMicros());
+        simLoop();
+
+        std::string out = MockSerial.getOutput();
+        if (!out.empty()) {
+            MockSerial.clearOutput();
+            usleep(out.size() * UART_US_PER_BYTE);  // The host sees a line once it is on the wire
+            if (write(master, out.data(), out.size()) < 0) _exit(0);
+        }
+    }
+}
+
+// A pty pair; with serve, a child process runs a simulated clock on it
+static std::string addClock(bool serve, uint32_t bootMs = 0, const char* preset = NULL) {
+    FakeClock c;
+    c.master = posix_openpt(O_RDWR | O_NOCTTY);
+    TEST_ASSERT_TRUE(c.master >= 0);
+    TEST_ASSERT_EQUAL(0, grantpt(c.master));
+    TEST_ASSERT_EQUAL(0, unlockpt(c.master));
+    c.path = ptsname(c.master);
+    c.slave = open(c.path.c_str(), O_RDWR | O_NOCTTY);
+    TEST_ASSERT_TRUE(c.slave >= 0);
+    // Raw at once: the default line discipline would echo boot output back to the clock
+    struct termios tio;
+    tcgetattr(c.slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(c.slave, TCSANOW, &tio);
+
+    c.pid = -1;
+    if (serve) {
+        fflush(stdout);
+        c.pid = fork();
+        TEST_ASSERT_TRUE(c.pid >= 0);
+        if (c.pid == 0) {
+            fcntl(c.master, F_SETFL, O_NONBLOCK);
+            serveClock(c.master, bootMs, preset);
+        }
+        close(c.master);
+        c.master = -1;
+    }
+    clocks.push_back(c);
+    return c.path;
+}
+
+static void stopClocks() {
+    for (FakeClock& c : clocks) {
+        if (c.pid > 0) {
+            kill(c.pid, SIGKILL);
+            waitpid(c.pid, NULL, 0);
+        }
+        if (c.master >= 0) close(c.master);
+        close(c.slave);
+    }
+    clocks.clear();
+}
+
+// Ask a clock for its RTC time (UTC seconds) with a J probe
+static long readClockUtc(const std::string& path) {
+    int fd = open(path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL(3, write(fd, "J0\n", 3));
+    std::string rx;
+    long utc = -1;
+    uint64_t deadline = wallUs() + 1000000;
+    while (utc < 0 && wallUs() < deadline) {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        poll(&pfd, 1, 10);
+        char buf[128];
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n > 0) rx.append(buf, n);
+        size_t at = rx.find("OK:J0 utc=");
+        if (at != std::string::npos && rx.find('\n', at) != std::string::npos) utc = atol(rx.c_str() + at + 10);
+    }
+    close(fd);
+    return utc;
+}
+
+// The error first, so a failure shows why
+static void assertSynced(const ProvisionResult& r) {
+    TEST_ASSERT_EQUAL_STRING("", r.error.c_str());
+    TEST_ASSERT_TRUE(r.ok);
+}
+
+static ClockConfig testConfig() {
+    ClockConfig c = defaultClockConfig();
+    c.tzId = 1;  // USA Eastern: local time differs from the UTC sent with D and T
+    c.format12h = 1;
+    c.brightness = 3;
+    c.scheduleEnabled = 1;
+    c.dimHour = 23;
+    c.dimMinute = 30;
+    c.dimBrightness = 0;
+    c.brightHour = 6;
+    c.brightMinute = 15;
+    c.brightBrightness = 7;
+    return c;
+}
+
+// ============================================================================
+// TEST: Single Clock
+// ============================================================================
+
+void test_provision_syncsAndVerifiesOneClock(void) {
+    std::string path = addClock(true);
+    std::vector<ProvisionResult> r = provisionClocks({path}, testConfig(), defaultProvisionOptions());
+
+    TEST_ASSERT_EQUAL(1, r.size());
+    assertSynced(r[0]);
+    TEST_ASSERT_EQUAL(11, r[0].replies);  // Z0 D T Z F B S N Y QF QS
+    TEST_ASSERT_EQUAL_STRING("enabled=1,dim=23:30:0,bright=06:15:7,blank=0", r[0].schedule.c_str());
+
+    // The RTC holds UTC regardless of the zone (Z0 around D and T)
+    long utc = readClockUtc(path);
+    long host = (long)time(NULL);
+    TEST_ASSERT_TRUE(utc >= host - 2 && utc <= host + 1);
+}
+
+void test_provision_waitsForBoot(void) {
+    std::string path = addClock(true, 1200);
+    std::vector<ProvisionResult> r = provisionClocks({path}, testConfig(), defaultProvisionOptions());
+
+    assertSynced(r[0]);
+    TEST_ASSERT_TRUE(r[0].readyMs >= 1200);
+}
+
+void test_provision_silentClock(void) {
+    // At V0 set commands do not reply: each is followed by P
+    std::string path = addClock(true, 0, "V0");
+    std::vector<ProvisionResult> r = provisionClocks({path}, testConfig(), defaultProvisionOptions());
+
+    assertSynced(r[0]);
+    TEST_ASSERT_EQUAL(11, r[0].replies);
+}
+
+// ============================================================================
+// TEST: Many Clocks
+// ============================================================================
+
+void test_provision_fiftyClocksAtOnce(void) {
+    std::vector<std::string> one = {addClock(true)};
+    uint64_t t0 = wallUs();
+    std::vector<ProvisionResult> r = provisionClocks(one, testConfig(), defaultProvisionOptions());
+    uint64_t singleUs = wallUs() - t0;
+    assertSynced(r[0]);
+
+    std::vector<std::string> many;
+    for (int i = 0; i < 50; i++) many.push_back(addClock(true));
+    t0 = wallUs();
+    r = provisionClocks(many, testConfig(), defaultProvisionOptions());
+    uint64_t batchUs = wallUs() - t0;
+
+    printf("provision: 1 clock %lu ms, 50 clocks %lu ms\n",
+           (unsigned long)(singleUs / 1000), (unsigned long)(batchUs / 1000));
+    TEST_ASSERT_EQUAL(50, r.size());
+    for (size_t i = 0; i < r.size(); i++) {
+        TEST_ASSERT_EQUAL_STRING(many[i].c_str(), r[i].port.c_str());
+        assertSynced(r[i]);
+    }
+    // Timings are only reported: 50 simulator processes share whatever CPU the
+    // host has, so a wall-clock bound would fail on a loaded machine
+}
+
+void test_provision_failuresStayPerClock(void) {
+    std::string good = addClock(true);
+    std::string mute = addClock(false);  // Port exists, nothing answers
+    ProvisionOptions options = defaultProvisionOptions();
+    options.bootTimeoutMs = 600;
+    std::vector<ProvisionResult> r = provisionClocks({mute, "/dev/nonexistent-clock", good},
+                                                     testConfig(), options);
+
+    TEST_ASSERT_FALSE(r[0].ok);
+    TEST_ASSERT_EQUAL_STRING("no reply to QV", r[0].error.c_str());
+    TEST_ASSERT_TRUE(r[0].totalMs >= 600);
+    TEST_ASSERT_FALSE(r[1].ok);
+    TEST_ASSERT_EQUAL_STRING("open: No such file or directory", r[1].error.c_str());
+    assertSynced(r[2]);
+}
+
+void setUp(void) {
+    // Each test starts its own clocks
+}
+
+void tearDown(void) {
+    stopClocks();
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Single clock tests
+    RUN_TEST(test_provision_syncsAndVerifiesOneClock);
+    RUN_TEST(test_provision_waitsForBoot);
+    RUN_TEST(test_provision_silentClock);
+
+    // Many clock tests
+    RUN_TEST(test_provision_fiftyClocksAtOnce);
+    RUN_TEST(test_provision_failuresStayPerClock);
+
+    return UNITY_END();
+}
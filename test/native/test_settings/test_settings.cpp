@@ -0,0 +1,214 @@
+#include "unity.h"
+#include <string.h>
+#include "settings.h"
+#include "crc16.h"
+
+// ============================================================================
+// EEPROM STAND-IN (erased EEPROM reads 0xFF)
+// ============================================================================
+
+static uint8_t eeprom[SETTINGS_RING_END];
+static uint16_t eepromWrites = 0;
+
+static uint8_t readByte(uint16_t addr) {
+  return eeprom[addr];
+}
+
+static void writeByte(uint16_t addr, uint8_t value) {
+  eeprom[addr] = value;
+  eepromWrites++;
+}
+
+// ============================================================================
+// TEST: CRC
+// ============================================================================
+
+void test_crc16_checkValue(void) {
+  // CRC-16/CCITT-FALSE check value for "123456789"
+  const char* check = "123456789";
+  TEST_ASSERT_EQUAL_HEX16(0x29B1, crc16((const uint8_t*)check, 9));
+}
+
+void test_crc16_chained(void) {
+  // Continuing over two buffers gives the same result as one pass
+  const char* check = "123456789";
+  uint16_t crc = crc16((const uint8_t*)check, 4);
+  crc = crc16((const uint8_t*)check + 4, 5, crc);
+  TEST_ASSERT_EQUAL_HEX16(0x29B1, crc);
+}
+
+// ============================================================================
+// TEST: Record layout
+// ============================================================================
+
+void test_settings_recordFitsRing(void) {
+  // One record per slot, several slots for wear levelling
+  TEST_ASSERT_EQUAL(24, SETTINGS_RECORD_SIZE);
+  TEST_ASSERT_EQUAL(40, SETTINGS_SLOT_COUNT);
+}
+
+// ============================================================================
+// TEST: Load / commit
+// ============================================================================
+
+void test_settings_emptyEepromHasNoRecord(void) {
+  Settings s;
+  SettingsRing ring;
+  TEST_ASSERT_FALSE(settingsLoad(s, ring, readByte));
+  TEST_ASSERT_FALSE(ring.valid);
+}
+
+void test_settings_commitThenLoad(void) {
+  Settings s;
+  SettingsRing ring;
+  settingsLoad(s, ring, readByte);
+  settingsDefaults(s);
+  s.tzId = 10;
+  s.format12h = 1;
+  s.dimHour = 23;
+  settingsCommit(s, ring, writeByte);
+
+  // One record write, in the first slot
+  TEST_ASSERT_EQUAL(SETTINGS_RECORD_SIZE, eepromWrites);
+  TEST_ASSERT_EQUAL(0, ring.slot);
+
+  Settings loaded;
+  SettingsRing ring2;
+  TEST_ASSERT_TRUE(settingsLoad(loaded, ring2, readByte));
+  TEST_ASSERT_EQUAL(10, loaded.tzId);
+  TEST_ASSERT_EQUAL(1, loaded.format12h);
+  TEST_ASSERT_EQUAL(23, loaded.dimHour);
+  TEST_ASSERT_EQUAL(ring.sequence, ring2.sequence);
+}
+
+void test_settings_newestWinsAfterWrap(void) {
+  Settings s;
+  SettingsRing ring;
+  settingsLoad(s, ring, readByte);
+  settingsDefaults(s);
+
+  // Go around the ring more than twice
+  for (uint8_t i = 0; i < 2 * SETTINGS_SLOT_COUNT + 5; i++) {
+    s.brightness = i % 8;
+    s.dimMinute = i % 60;
+    settingsCommit(s, ring, writeByte);
+  }
+
+  Settings loaded;
+  SettingsRing ring2;
+  TEST_ASSERT_TRUE(settingsLoad(loaded, ring2, readByte));
+  TEST_ASSERT_EQUAL(s.brightness, loaded.brightness);
+  TEST_ASSERT_EQUAL(s.dimMinute, loaded.dimMinute);
+  TEST_ASSERT_EQUAL(4, ring2.slot);
+}
+
+void test_settings_corruptRecordFallsBack(void) {
+  Settings s;
+  SettingsRing ring;
+  settingsLoad(s, ring, readByte);
+  settingsDefaults(s);
+  s.tzId = 1;
+  settingsCommit(s, ring, writeByte);
+  s.tzId = 2;
+  settingsCommit(s, ring, writeByte);
+
+  // Torn write of the newest record: its CRC no longer matches
+  eeprom[SETTINGS_RING_START + SETTINGS_RECORD_SIZE + 5] ^= 0x01;
+
+  Settings loaded;
+  SettingsRing ring2;
+  TEST_ASSERT_TRUE(settingsLoad(loaded, ring2, readByte));
+  TEST_ASSERT_EQUAL(1, loaded.tzId);
+  TEST_ASSERT_EQUAL(0, ring2.slot);
+}
+
+void test_settings_sequenceWraps(void) {
+  Settings s;
+  SettingsRing ring;
+  settingsDefaults(s);
+
+  // Sequence 0xFFFF in slot 0, 0x0000 in slot 1: slot 1 is newer
+  ring.valid = true;
+  ring.slot = SETTINGS_SLOT_COUNT - 1;
+  ring.sequence = 0xFFFE;
+  s.brightness = 3;
+  settingsCommit(s, ring, writeByte);
+  s.brightness = 6;
+  settingsCommit(s, ring, writeByte);
+  TEST_ASSERT_EQUAL(0, ring.sequence);
+
+  Settings loaded;
+  SettingsRing ring2;
+  TEST_ASSERT_TRUE(settingsLoad(loaded, ring2, readByte));
+  TEST_ASSERT_EQUAL(6, loaded.brightness);
+  TEST_ASSERT_EQUAL(1, ring2.slot);
+}
+
+// ============================================================================
+// TEST: Sanitize
+// ============================================================================
+
+void test_settings_sanitizeErasedLegacyBytes(void) {
+  // Legacy bytes read 0xFF on a fresh chip: every field falls back to its default
+  Settings s;
+  memset(&s, 0xFF, sizeof(s));
+  settingsSanitize(s, 20);
+  TEST_ASSERT_EQUAL(5, s.brightness);
+  TEST_ASSERT_EQUAL(0, s.format12h);
+  TEST_ASSERT_EQUAL(0, s.tzId);
+  TEST_ASSERT_EQUAL(0, s.scheduleEnabled);
+  TEST_ASSERT_EQUAL(22, s.dimHour);
+  TEST_ASSERT_EQUAL(0, s.dimMinute);
+  TEST_ASSERT_EQUAL(1, s.dimBrightness);
+  TEST_ASSERT_EQUAL(7, s.brightHour);
+  TEST_ASSERT_EQUAL(0, s.brightMinute);
+  TEST_ASSERT_EQUAL(5, s.brightBrightness);
+}
+
+void test_settings_sanitizeKeepsValidValues(void) {
+  Settings s;
+  settingsDefaults(s);
+  s.tzId = 20;
+  s.brightness = 7;
+  s.dimHour = 0;
+  settingsSanitize(s, 20);
+  TEST_ASSERT_EQUAL(20, s.tzId);
+  TEST_ASSERT_EQUAL(7, s.brightness);
+  TEST_ASSERT_EQUAL(0, s.dimHour);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void setUp(void) {
+  // Fresh, erased EEPROM for each test
+  memset(eeprom, 0xFF, sizeof(eeprom));
+  eepromWrites = 0;
+}
+
+void tearDown(void) {
+  // Run after each test
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  
+  // CRC tests
+  RUN_TEST(test_crc16_checkValue);
+  RUN_TEST(test_crc16_chained);
+  
+  // Ring tests
+  RUN_TEST(test_settings_recordFitsRing);
+  RUN_TEST(test_settings_emptyEepromHasNoRecord);
+  RUN_TEST(test_settings_commitThenLoad);
+  RUN_TEST(test_settings_newestWinsAfterWrap);
+  RUN_TEST(test_settings_corruptRecordFallsBack);
+  RUN_TEST(test_settings_sequenceWraps);
+  
+  // Sanitize tests
+  RUN_TEST(test_settings_sanitizeErasedLegacyBytes);
+  RUN_TEST(test_settings_sanitizeKeepsValidValues);
+  
+  return UNITY_END();
+}
@@ -0,0 +1,356 @@
+#include "unity.h"
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include "Simulator.h"
+#include "command.h"
+#include "frame.h"
+
+// Native simulator tests: src/main.cpp built with HAL_NATIVE, driven through
+// its serial protocol and observed on the mocked display, RTC and EEPROM
+
+#define SECONDS_PER_DAY   86400UL
+#define MINUTES_PER_YEAR  (365UL * 24 * 60)
+
+static bool contains(const std::string& text, const char* part) {
+    return text.find(part) != std::string::npos;
+}
+
+// Send raw bytes (setInput() stops at a NUL) and run loop() until they are read
+static std::string simSendBytes(const uint8_t* data, uint8_t len) {
+    MockSerial.clearOutput();
+    for (uint8_t i = 0; i < len; i++) {
+        const char one[2] = {(char)data[i], '\0'};
+        MockSerial.setInput(one);
+    }
+    simDrainInput();
+    return MockSerial.getOutput();
+}
+
+// Status byte of the reply frame at the start of out (-1 if there is none)
+static int replyFrameStatus(const std::string& out, uint8_t op) {
+    if (out.size() < FRAME_OVERHEAD + 2 || (uint8_t)out[0] != FRAME_SYNC) return -1;
+    if ((uint8_t)out[2] != (op | FRAME_REPLY)) return -1;
+    return (uint8_t)out[3];
+}
+
+// ============================================================================
+// TEST: Boot and Serial Protocol
+// ============================================================================
+
+void test_sim_bootShowsRtcTime(void) {
+    simBoot(MockDateTime(2026, 6, 1, 12, 34, 56));
+    TEST_ASSERT_TRUE(contains(MockSerial.getOutput(), "DBG:Boot"));
+    TEST_ASSERT_EQUAL_STRING("12:34", simDisplayText().c_str());
+
+    // A new board writes its first settings record (migrated from the legacy bytes)
+    TEST_ASSERT_TRUE(MockEEPROM.writeCount > 0);
+}
+
+void test_sim_commandsRoundTrip(void) {
+    simBoot(MockDateTime(2026, 6, 1, 12, 0, 0));
+    TEST_ASSERT_TRUE(contains(simCommand("QF"), "OK:QF0"));
+    TEST_ASSERT_TRUE(contains(simCommand("F1"), "OK:F1"));
+    TEST_ASSERT_EQUAL_STRING("12:00", simDisplayText().c_str());
+    TEST_ASSERT_TRUE(contains(simCommand("T13,5,0"), "OK:T13:5:0"));
+    TEST_ASSERT_EQUAL_STRING(" 1:05", simDisplayText().c_str());
+    TEST_ASSERT_TRUE(contains(simCommand("B9"), "ERR:B"));
+}
+
+void test_sim_settingsSurviveReboot(void) {
+    simBoot(MockDateTime(2026, 6, 1, 12, 0, 0));
+    simCommand("Z1");
+    simCommand("F1");
+    simRunSeconds(5);  // Past the settings commit delay
+
+    simBoot(MockDateTime(2026, 6, 1, 12, 0, 5), true);
+    TEST_ASSERT_TRUE(contains(simCommand("QF"), "OK:QF1"));
+    TEST_ASSERT_EQUAL_STRING(" 8:00", simDisplayText().c_str());  // EDT, 12h
+}
+
+void test_sim_corruptFrameThenResend(void) {
+    simBoot(MockDateTime(2026, 6, 1, 12, 0, 0));
+    const uint8_t body[] = {CMD_BRIGHTNESS, 3};
+    uint8_t frame[FRAME_MAX_SIZE];
+    uint8_t size = frameEncode(frame, body, sizeof(body));
+
+    // LEN 2 -> 1: the CRC check lands early, the last byte is still to come
+    uint8_t corrupt[FRAME_MAX_SIZE];
+    memcpy(corrupt, frame, size);
+    corrupt[1] = 1;
+    TEST_ASSERT_EQUAL(FRAME_STATUS_BAD_CRC, replyFrameStatus(simSendBytes(corrupt, size), CMD_NONE));
+
+    // The host resends after the gap: answered, and no debris left in the text line
+    simRunMicros((FRAME_TIMEOUT_MS + 50) * 1000UL);
+    TEST_ASSERT_EQUAL(PARSE_OK, replyFrameStatus(simSendBytes(frame, size), CMD_BRIGHTNESS));
+    TEST_ASSERT_TRUE(contains(simCommand("QF"), "OK:QF0"));
+
+    // A partial text line that went quiet does not hide a frame either
+    MockSerial.setInput("Q");
+    simDrainInput();
+    simRunMicros((FRAME_TIMEOUT_MS + 50) * 1000UL);
+    TEST_ASSERT_EQUAL(PARSE_OK, replyFrameStatus(simSendBytes(frame, size), CMD_BRIGHTNESS));
+    TEST_ASSERT_TRUE(contains(simCommand("QF"), "OK:QF0"));
+}
+
+void test_sim_countersTrackTicksAndWrites(void) {
+    simBoot(MockDateTime(2026, 6, 1, 12, 0, 0));
+    TEST_ASSERT_TRUE(contains(simCommand("RC"), "OK:RC"));
+    simRunSeconds(10);
+    std::string counters = simCommand("QC");
+    TEST_ASSERT_TRUE(contains(counters, "OK:QC up=10,"));
+    TEST_ASSERT_TRUE(contains(counters, ",ticks=10,"));
+    TEST_ASSERT_TRUE(contains(counters, ",i2c=20,"));  // One RTC read per tick
+    TEST_ASSERT_TRUE(contains(counters, ",eeprom=0,"));
+
+    simCommand("Z1");
+    simRunSeconds(5);  // Past the settings commit delay
+    TEST_ASSERT_FALSE(contains(simCommand("QC"), ",eeprom=0,"));
+}
+
+// ============================================================================
+// TEST: Time Keeping
+// ============================================================================
+
+void test_sim_springForwardUSAEastern(void) {
+    // 2026-03-08 07:00 UTC: 01:59:59 EST -> 03:00:00 EDT
+    simBoot(MockDateTime(2026, 3, 8, 6, 59, 0));
+    simCommand("Z1");
+    simRunSeconds(1);  // The display follows on the next tick
+    TEST_ASSERT_EQUAL_STRING("01:59", simDisplayText().c_str());
+    simRunSeconds(59);
+    TEST_ASSERT_EQUAL_STRING("03:00", simDisplayText().c_str());
+}
+
+void test_sim_fractionalOffsetZones(void) {
+    // Adelaide is UTC+9:30 in winter and UTC+10:30 from the first Sunday of October
+    simBoot(MockDateTime(2026, 6, 1, 0, 0, 0));
+    TEST_ASSERT_TRUE(contains(simCommand("Z17"), "OK:Z17"));
+    simRunSeconds(1);
+    TEST_ASSERT_EQUAL_STRING("09:30", simDisplayText().c_str());
+
+    simBoot(MockDateTime(2026, 10, 3, 16, 29, 0));  // 02:59 ACST
+    simCommand("Z17");
+    simRunSeconds(1);
+    TEST_ASSERT_EQUAL_STRING("01:59", simDisplayText().c_str());
+    simRunSeconds(60);
+    TEST_ASSERT_EQUAL_STRING("03:00", simDisplayText().c_str());
+
+    // India (UTC+5:30) and Nepal (UTC+5:45): no DST
+    simCommand("Z21");
+    simRunSeconds(1);
+    TEST_ASSERT_EQUAL_STRING("22:00", simDisplayText().c_str());
+    simCommand("Z22");
+    simRunSeconds(1);
+    TEST_ASSERT_EQUAL_STRING("22:15", simDisplayText().c_str());
+}
+
+// Host clock in µs since the epoch: the RTC boots 1.35 s behind it
+static uint64_t hostMicros(uint64_t bootUtc) {
+    return bootUtc * 1000000ULL + 1350000ULL + MockTiming::nowMicros();
+}
+
+// RTC time in µs since the epoch reported by a J probe
+static uint64_t probeRtc(uint8_t slot) {
+    char line[8];
+    snprintf(line, sizeof(line), "J%u", slot);
+    std::string out = simCommand(line);
+    unsigned utc = 0, us = 0;
+    sscanf(out.c_str() + out.find("OK:J"), "OK:J%*u utc=%u,us=%u", &utc, &us);
+    return utc * 1000000ULL + us;
+}
+
+// The host's side of a precise set: W for its next whole second at least 200 ms
+// out, as a delay after a fresh probe in slot 0
+static std::string hostPreciseSet(uint32_t bootUtc) {
+    probeRtc(0);
+    uint64_t host = hostMicros(bootUtc);
+    uint32_t target = (uint32_t)((host + 200000) / 1000000 + 1);
+    uint32_t delayMs = (uint32_t)((target * 1000000ULL - host) / 1000);
+    MockDateTime t(target);
+    char line[48];
+    snprintf(line, sizeof(line), "W0,%u,%u,%u,%u,%u,%u,%u", delayMs,
+             t.month(), t.day(), t.year(), t.hour(), t.minute(), t.second());
+    return simCommand(line);
+}
+
+// RTC minus host clock in µs, from a J probe
+static int64_t rtcOffsetMicros(uint32_t bootUtc, uint8_t slot) {
+    return (int64_t)(probeRtc(slot) - hostMicros(bootUtc));
+}
+
+void test_sim_preciseTimeSet(void) {
+    uint32_t bootUtc = MockDateTime(2026, 6, 1, 12, 0, 0).unixtime();
+    simBoot(MockDateTime(bootUtc));
+    simRunMicros(2250000);  // Mid-second
+    TEST_ASSERT_INT32_WITHIN(1000, -1350000, (int32_t)rtcOffsetMicros(bootUtc, 1));
+
+    TEST_ASSERT_FALSE(contains(hostPreciseSet(bootUtc), "OK:W"));  // Replies once written
+    simRunMicros(1500000);
+    TEST_ASSERT_TRUE(contains(MockSerial.getOutput(), "OK:W utc="));
+
+    // The RTC's second boundary now falls on the host's
+    TEST_ASSERT_INT32_WITHIN(1000, 0, (int32_t)rtcOffsetMicros(bootUtc, 1));
+    simRunSeconds(3);
+    TEST_ASSERT_INT32_WITHIN(1000, 0, (int32_t)rtcOffsetMicros(bootUtc, 2));
+
+    // A slot never probed, or a delay already past, is rejected
+    TEST_ASSERT_TRUE(contains(simCommand("W5,500,6,1,2026,12,0,0"), "ERR:W no probe"));
+    TEST_ASSERT_TRUE(contains(simCommand("W0,500,6,1,2026,12,0,0"), "ERR:W late"));
+}
+
+// Drift since the last precise set in ppm, as the dashboard computes it
+static double measureDriftPpm(uint32_t bootUtc) {
+    std::string reply = simCommand("QG");
+    unsigned setUtc = 0;
+    sscanf(reply.c_str() + reply.find("OK:QG"), "OK:QG aging=%*d,set=%u", &setUtc);
+    TEST_ASSERT_TRUE(setUtc != 0);
+    double elapsedUs = (double)(hostMicros(bootUtc) - setUtc * 1000000ULL);
+    return (double)rtcOffsetMicros(bootUtc, 1) / elapsedUs * 1e6;
+}
+
+void test_sim_driftCalibration(void) {
+    uint32_t bootUtc = MockDateTime(2026, 6, 1, 12, 0, 0).unixtime();
+    simBoot(MockDateTime(bootUtc));
+    rtc.setDriftPpm(8.0);  // Fast crystal: ~0.7 s a day
+    // Measured over three days: the firmware never writes the RTC on its own
+    simRunMicros(2250000);
+    hostPreciseSet(bootUtc);
+    simRunMicros(1500000);
+    simRunSeconds(3 * SECONDS_PER_DAY);
+    double before = measureDriftPpm(bootUtc);
+    TEST_ASSERT_TRUE(before > 7.9 && before < 8.1);
+
+    // Trim (+1 slows by 0.1 ppm); a new rate clears the baseline until the next set
+    char line[8];
+    snprintf(line, sizeof(line), "G%d", (int)(before / 0.1 + 0.5));
+    TEST_ASSERT_TRUE(contains(simCommand(line), "OK:G80"));
+    TEST_ASSERT_TRUE(contains(simCommand("QG"), "OK:QG aging=80,set=0"));
+    simRunSeconds(5);  // Past the settings commit delay
+
+    // The RTC loses the register with its power; the firmware restores it at boot
+    rtc.setAging(0);
+    simBoot(MockDateTime(bootUtc), true);
+    TEST_ASSERT_EQUAL(80, rtc.aging());
+
+    simRunMicros(2250000);
+    hostPreciseSet(bootUtc);
+    simRunMicros(1500000);
+    simRunSeconds(3 * SECONDS_PER_DAY);
+    double after = measureDriftPpm(bootUtc);
+    TEST_ASSERT_TRUE(after > -0.1 && after < 0.1);
+}
+
+// ============================================================================
+// TEST: Power
+// ============================================================================
+
+void test_sim_nightBlankingAndCurrent(void) {
+    simBoot(MockDateTime(2026, 6, 1, 0, 0, 0));  // UTC, schedule 22:00-07:00
+    simCommand("N22,0,0");
+    simCommand("S1");
+    MockPower.reset();
+    simRunSeconds(SECONDS_PER_DAY);
+    double dimmedMa = MockPower.displayAverageMa();
+    double mcuMa = MockPower.mcuAverageMa();
+
+    // Night blanking: level 0 is still lit, blanked is dark
+    TEST_ASSERT_TRUE(contains(simCommand("K1"), "OK:K1"));
+    MockPower.reset();
+    simRunSeconds(23 * 3600);
+    TEST_ASSERT_EQUAL_STRING("     ", simDisplayText().c_str());
+    simRunSeconds(SECONDS_PER_DAY - 23 * 3600);
+    double blankedMa = MockPower.displayAverageMa();
+    simRunSeconds(8 * 3600);
+    TEST_ASSERT_EQUAL_STRING("08:00", simDisplayText().c_str());
+
+    char message[128];
+    snprintf(message, sizeof(message), "Average current: MCU %.2f mA (%.2f mA without sleep), "
+             "display %.1f mA dimmed / %.1f mA blanked at night",
+             mcuMa, MockPower.mcuAlwaysActiveMa(), dimmedMa, blankedMa);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(mcuMa < MockPower.mcuAlwaysActiveMa() / 2);
+    TEST_ASSERT_TRUE(blankedMa < dimmedMa);
+}
+
+void test_sim_yearOfOperation(void) {
+    simBoot(MockDateTime(2026, 1, 1, 0, 0, 0));
+    simCommand("RC");  // Counters are not cleared between simulated boots
+    uint32_t bootWrites = MockEEPROM.writeCount;
+    uint32_t bootTransfers = display.transfers;
+
+    auto start = std::chrono::steady_clock::now();
+    simRunSeconds(365 * SECONDS_PER_DAY);
+    double hostSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    char message[96];
+    snprintf(message, sizeof(message), "1 simulated year in %.1f s host time", hostSeconds);
+    TEST_MESSAGE(message);
+
+    // One display transfer per minute, no settings writes without commands
+    TEST_ASSERT_EQUAL(MINUTES_PER_YEAR, display.transfers - bootTransfers);
+    TEST_ASSERT_EQUAL(bootWrites, MockEEPROM.writeCount);
+    TEST_ASSERT_EQUAL_STRING("00:00", simDisplayText().c_str());
+
+    // The date is the RTC's own calendar: never written, one housekeeping run per day
+    TEST_ASSERT_EQUAL(0, rtc.adjustCount);
+    TEST_ASSERT_EQUAL_UINT32(MockDateTime(2027, 1, 1, 0, 0, 0).unixtime(), rtc.unixtime());
+    TEST_ASSERT_TRUE(contains(simCommand("QC"), ",days=365"));
+}
+
+void test_sim_dayChangesAcrossYears(void) {
+    // USA Eastern across two DST seasons and the 2028 leap day
+    simBoot(MockDateTime(2027, 6, 1, 12, 0, 0));
+    simCommand("Z1");
+    simRunSeconds(5);
+    uint32_t writes = rtc.adjustCount;
+    simCommand("RC");
+
+    // Local midnight is 04:00 UTC in summer, 05:00 UTC in winter
+    simRunSeconds(16 * 3600 - 5);
+    TEST_ASSERT_EQUAL_STRING("00:00", simDisplayText().c_str());
+    TEST_ASSERT_TRUE(contains(simCommand("QC"), ",days=1"));
+    simRunSeconds(730 * SECONDS_PER_DAY);
+
+    // 730 days later, with 2028-02-29 on the way: 00:00 EDT on 2029-06-01
+    TEST_ASSERT_EQUAL_UINT32(MockDateTime(2029, 6, 1, 4, 0, 0).unixtime(), rtc.unixtime());
+    TEST_ASSERT_EQUAL_STRING("00:00", simDisplayText().c_str());
+    TEST_ASSERT_TRUE(contains(simCommand("QC"), ",days=731"));
+    TEST_ASSERT_EQUAL(writes, rtc.adjustCount);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void setUp(void) {
+    // Each test boots the simulator itself
+}
+
+void tearDown(void) {
+    // Run after each test
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Boot and serial protocol tests
+    RUN_TEST(test_sim_bootShowsRtcTime);
+    RUN_TEST(test_sim_commandsRoundTrip);
+    RUN_TEST(test_sim_settingsSurviveReboot);
+    RUN_TEST(test_sim_countersTrackTicksAndWrites);
+    RUN_TEST(test_sim_corruptFrameThenResend);
+
+    // Time keeping tests
+    RUN_TEST(test_sim_springForwardUSAEastern);
+    RUN_TEST(test_sim_fractionalOffsetZones);
+    RUN_TEST(test_sim_preciseTimeSet);
+    RUN_TEST(test_sim_driftCalibration);
+    RUN_TEST(test_sim_yearOfOperation);
+    RUN_TEST(test_sim_dayChangesAcrossYears);
+
+    // Power tests
+    RUN_TEST(test_sim_nightBlankingAndCurrent);
+
+    return UNITY_END();
+}
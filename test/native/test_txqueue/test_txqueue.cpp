@@ -0,0 +1,76 @@
+#include "unity.h"
+#include <string.h>
+#include "txqueue.h"
+
+static TxQueue q;
+
+// ============================================================================
+// TEST: Queue / Drain
+// ============================================================================
+
+void test_txQueue_fifoOrder(void) {
+  const char* text = "OK:B5\r\n";
+  for (uint8_t i = 0; i < strlen(text); i++) {
+    TEST_ASSERT_TRUE(txQueuePut(q, text[i]));
+  }
+
+  // Drained in pieces, as the UART buffer frees up
+  uint8_t out[16];
+  uint8_t n = txQueueTake(q, out, 3);
+  n += txQueueTake(q, out + n, sizeof(out) - n);
+  TEST_ASSERT_EQUAL(strlen(text), n);
+  TEST_ASSERT_EQUAL_MEMORY(text, out, n);
+  TEST_ASSERT_TRUE(txQueueEmpty(q));
+}
+
+void test_txQueue_fullQueueRefusesWithoutLoss(void) {
+  for (uint16_t i = 0; i < TX_QUEUE_SIZE; i++) {
+    TEST_ASSERT_TRUE(txQueuePut(q, (uint8_t)i));
+  }
+  TEST_ASSERT_FALSE(txQueuePut(q, 0xEE));
+  TEST_ASSERT_EQUAL(TX_QUEUE_SIZE, q.peak);
+
+  // Free one byte: the refused byte fits and lands at the end
+  uint8_t b;
+  TEST_ASSERT_EQUAL(1, txQueueTake(q, &b, 1));
+  TEST_ASSERT_EQUAL(0, b);
+  TEST_ASSERT_TRUE(txQueuePut(q, 0xEE));
+
+  uint8_t out[TX_QUEUE_SIZE];
+  TEST_ASSERT_EQUAL(TX_QUEUE_SIZE, txQueueTake(q, out, TX_QUEUE_SIZE));
+  TEST_ASSERT_EQUAL(1, out[0]);
+  TEST_ASSERT_EQUAL_HEX8(0xEE, out[TX_QUEUE_SIZE - 1]);
+}
+
+void test_txQueue_wrapsAround(void) {
+  // Many small replies through the ring, each read back intact
+  uint8_t out[5];
+  for (uint16_t round = 0; round < 300; round++) {
+    for (uint8_t i = 0; i < 5; i++) txQueuePut(q, (uint8_t)(round + i));
+    TEST_ASSERT_EQUAL(5, txQueueTake(q, out, sizeof(out)));
+    for (uint8_t i = 0; i < 5; i++) TEST_ASSERT_EQUAL((uint8_t)(round + i), out[i]);
+  }
+  TEST_ASSERT_EQUAL(5, q.peak);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void setUp(void) {
+  txQueueReset(q);
+}
+
+void tearDown(void) {
+  // Run after each test
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_txQueue_fifoOrder);
+  RUN_TEST(test_txQueue_fullQueueRefusesWithoutLoss);
+  RUN_TEST(test_txQueue_wrapsAround);
+
+  return UNITY_END();
+}
@@ -0,0 +1,371 @@
+#include "provision.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <deque>
+
+#define PHASE_PROBE 0  // Waiting for the first QV reply
+#define PHASE_SYNC  1  // Commands queued or in flight
+#define PHASE_DONE  2
+
+#define LINE_MAX_LEN 128  // Longest device line (OK:QC is about 90)
+
+struct PendingCommand {
+  std::string text;  // Without the line terminator
+  std::string ack;   // Reply prefix after OK:/ERR:, e.g. "QS" (or "P" when fenced)
+  bool fenced;       // Silent device: followed by P, whose reply stands in for its own
+  uint32_t bytes;    // On the wire, including the P
+  uint64_t queuedUs;
+};
+
+struct Port {
+  ProvisionResult result;
+  int fd;
+  uint8_t phase;
+  uint8_t verbosity;
+  std::string rx;                       // Partial line
+  std::string tx;                       // Bytes not written yet
+  std::deque<PendingCommand> queue;     // Waiting for room in the window
+  std::deque<PendingCommand> inFlight;  // Sent, waiting for the reply, oldest first
+  uint32_t inFlightBytes;
+  uint64_t openedUs;
+  uint64_t lastProbeUs;
+  uint64_t syncStartUs;
+};
+
+static uint64_t nowUs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static bool startsWith(const std::string& text, const std::string& prefix) {
+  return text.compare(0, prefix.size(), prefix) == 0;
+}
+
+ClockConfig defaultClockConfig() {
+  ClockConfig c;
+  c.format12h = 0;
+  c.tzId = 0;
+  c.brightness = 5;
+  c.scheduleEnabled = 0;
+  c.dimHour = 22;
+  c.dimMinute = 0;
+  c.dimBrightness = 1;
+  c.brightHour = 7;
+  c.brightMinute = 0;
+  c.brightBrightness = 5;
+  return c;
+}
+
+ProvisionOptions defaultProvisionOptions() {
+  ProvisionOptions o;
+  o.commandTimeoutMs = PROVISION_COMMAND_TIMEOUT_MS;
+  o.bootTimeoutMs = PROVISION_BOOT_TIMEOUT_MS;
+  return o;
+}
+
+std::string expectedSchedule(const ClockConfig& c) {
+  char buf[48];
+  snprintf(buf, sizeof(buf), "enabled=%u,dim=%02u:%02u:%u,bright=%02u:%02u:%u",
+           c.scheduleEnabled, c.dimHour, c.dimMinute, c.dimBrightness,
+           c.brightHour, c.brightMinute, c.brightBrightness);
+  return buf;
+}
+
+// Raw 8N1, non-blocking, at 9600: the firmware always boots at that rate and the
+// tool never sends U. Pseudo-terminals accept (and ignore) the rate.
+static int openSerial(const std::string& path, std::string& error) {
+  int fd = open(path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (fd < 0) {
+    error = std::string("open: ") + strerror(errno);
+    return -1;
+  }
+  struct termios tio;
+  if (tcgetattr(fd, &tio) != 0) {
+    error = std::string("tcgetattr: ") + strerror(errno);
+    close(fd);
+    return -1;
+  }
+  cfmakeraw(&tio);
+  tio.c_cflag |= CLOCAL | CREAD;
+  tio.c_cc[VMIN] = 0;
+  tio.c_cc[VTIME] = 0;
+  cfsetispeed(&tio, B9600);
+  cfsetospeed(&tio, B9600);
+  if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+    error = std::string("tcsetattr: ") + strerror(errno);
+    close(fd);
+    return -1;
+  }
+  tcflush(fd, TCIOFLUSH);
+  return fd;
+}
+
+static void finish(Port& p, const std::string& error) {
+  if (p.phase == PHASE_DONE) return;
+  p.phase = PHASE_DONE;
+  p.result.ok = error.empty();
+  p.result.error = error;
+  p.result.totalMs = (uint32_t)((nowUs() - p.openedUs) / 1000);
+  if (p.syncStartUs) p.result.syncMs = (uint32_t)((nowUs() - p.syncStartUs) / 1000);
+  if (p.fd >= 0) {
+    close(p.fd);
+    p.fd = -1;
+  }
+}
+
+// Commands that reply even at V0 (commandAlwaysReplies() in src/command.cpp)
+static bool alwaysReplies(const std::string& name) {
+  return name[0] == 'Q' || (name.size() == 1 && strchr("HUPVJW", name[0]));
+}
+
+static void enqueue(Port& p, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+static void enqueue(Port& p, const char* fmt, ...) {
+  char buf[32];
+  va_list ap;
+  va_start(ap, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+
+  PendingCommand cmd;
+  cmd.text = buf;
+  std::string name = cmd.text[0] == 'Q' ? cmd.text.substr(0, 2) : cmd.text.substr(0, 1);
+  cmd.fenced = p.verbosity == 0 && !alwaysReplies(name);
+  cmd.ack = cmd.fenced ? "P" : name;
+  cmd.bytes = cmd.text.size() + 1 + (cmd.fenced ? 2 : 0);
+  cmd.queuedUs = 0;
+  p.queue.push_back(cmd);
+}
+
+// Move queued commands to the output while they fit the device's receive buffer
+static void pump(Port& p) {
+  while (!p.queue.empty() &&
+         (p.inFlight.empty() || p.inFlightBytes + p.queue.front().bytes <= PROVISION_RX_WINDOW)) {
+    PendingCommand cmd = p.queue.front();
+    p.queue.pop_front();
+    p.tx += cmd.text;
+    p.tx += '\n';
+    if (cmd.fenced) p.tx += "P\n";
+    cmd.queuedUs = nowUs();
+    p.inFlightBytes += cmd.bytes;
+    p.inFlight.push_back(cmd);
+  }
+}
+
+static void startSync(Port& p, const ClockConfig& c) {
+  p.phase = PHASE_SYNC;
+  p.syncStartUs = nowUs();
+  p.result.readyMs = (uint32_t)((p.syncStartUs - p.openedUs) / 1000);
+
+  // UTC to the nearest second, taken as late as possible: D and T leave together
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  time_t utc = ts.tv_sec + (ts.tv_nsec >= 500000000 ? 1 : 0);
+  struct tm t;
+  gmtime_r(&utc, &t);
+
+  enqueue(p, "Z0");
+  enqueue(p, "D%d,%d,%d", t.tm_mon + 1, t.tm_mday, t.tm_year + 1900);
+  enqueue(p, "T%d,%d,%d", t.tm_hour, t.tm_min, t.tm_sec);
+  enqueue(p, "Z%u", c.tzId);
+  enqueue(p, "F%u", c.format12h);
+  enqueue(p, "B%u", c.brightness);
+  enqueue(p, "S%u", c.scheduleEnabled);
+  enqueue(p, "N%u,%u,%u", c.dimHour, c.dimMinute, c.dimBrightness);
+  enqueue(p, "Y%u,%u,%u", c.brightHour, c.brightMinute, c.brightBrightness);
+  enqueue(p, "QF");
+  enqueue(p, "QS");
+  pump(p);
+}
+
+// Check a query reply against the requested settings
+static bool verifyReply(Port& p, const PendingCommand& cmd, const std::string& line, const ClockConfig& c) {
+  if (cmd.text == "QF") {
+    if (line != std::string("OK:QF") + (c.format12h ? "1" : "0")) {
+      finish(p, "format not applied: " + line);
+      return false;
+    }
+  } else if (cmd.text == "QS") {
+    p.result.schedule = line.size() > 6 ? line.substr(6) : "";
+    if (!startsWith(p.result.schedule, expectedSchedule(c))) {
+      finish(p, "schedule not applied: " + line);
+      return false;
+    }
+  }
+  return true;
+}
+
+static void handleLine(Port& p, const std::string& line, const ClockConfig& c) {
+  if (p.phase == PHASE_PROBE) {
+    // Firmware without V (no output levels) rejects QV but is just as ready
+    bool levelReply = startsWith(line, "OK:QV level=");
+    if (levelReply || line == "ERR:UNKNOWN QV") {
+      p.verbosity = levelReply ? (uint8_t)atoi(line.c_str() + 12) : 2;
+      startSync(p, c);
+    }
+    return;
+  }
+  if (p.phase != PHASE_SYNC) return;
+
+  if (line == "ERR:RX overflow") {
+    finish(p, "device receive overflow");
+    return;
+  }
+  // The oldest command this line answers (DBG lines and stray probe replies match none)
+  for (size_t i = 0; i < p.inFlight.size(); i++) {
+    const PendingCommand& cmd = p.inFlight[i];
+    bool ok = startsWith(line, "OK:" + cmd.ack);
+    if (!ok && !startsWith(line, "ERR:" + cmd.ack) && line != "ERR:UNKNOWN " + cmd.text) continue;
+    if (!ok) {
+      finish(p, cmd.text + ": " + line);
+      return;
+    }
+    uint32_t rttMs = (uint32_t)((nowUs() - cmd.queuedUs) / 1000);
+    if (rttMs > p.result.rttMaxMs) p.result.rttMaxMs = rttMs;
+    p.result.replies++;
+    if (!verifyReply(p, cmd, line, c)) return;
+    p.inFlightBytes -= cmd.bytes;
+    p.inFlight.erase(p.inFlight.begin() + i);
+    pump(p);
+    if (p.queue.empty() && p.inFlight.empty()) finish(p, "");
+    return;
+  }
+}
+
+static void readPort(Port& p, const ClockConfig& c) {
+  char buf[256];
+  for (;;) {
+    // Raw mode with VMIN = VTIME = 0: 0 means no data, not end of file
+    ssize_t n = read(p.fd, buf, sizeof(buf));
+    if (n == 0 || (n < 0 && (errno == EAGAIN || errno == EINTR))) return;
+    if (n < 0) {
+      finish(p, std::string("read: ") + strerror(errno));
+      return;
+    }
+    for (ssize_t i = 0; i < n && p.phase != PHASE_DONE; i++) {
+      char ch = buf[i];
+      if (ch == '\r' || ch == '\n') {
+        if (!p.rx.empty()) {
+          std::string line;
+          line.swap(p.rx);
+          handleLine(p, line, c);
+        }
+      } else if (p.rx.size() < LINE_MAX_LEN) {
+        p.rx += ch;
+      }
+    }
+    if (p.phase == PHASE_DONE) return;
+  }
+}
+
+static void writePort(Port& p) {
+  while (!p.tx.empty()) {
+    ssize_t n = write(p.fd, p.tx.data(), p.tx.size());
+    if (n < 0 && (errno == EAGAIN || errno == EINTR)) return;
+    if (n < 0) {
+      finish(p, std::string("write: ") + strerror(errno));
+      return;
+    }
+    p.tx.erase(0, n);
+  }
+}
+
+// Probe repeats and reply timeouts; returns ms until the port next needs attention
+static uint32_t checkTimers(Port& p, const ProvisionOptions& o) {
+  uint64_t now = nowUs();
+  if (p.phase == PHASE_PROBE) {
+    if (now - p.openedUs >= (uint64_t)o.bootTimeoutMs * 1000) {
+      finish(p, "no reply to QV");
+      return 0;
+    }
+    uint64_t next = p.lastProbeUs + PROVISION_PROBE_INTERVAL_MS * 1000;
+    if (p.lastProbeUs == 0 || now >= next) {
+      p.tx += "QV\n";
+      p.lastProbeUs = now;
+      return PROVISION_PROBE_INTERVAL_MS;
+    }
+    return (uint32_t)((next - now) / 1000) + 1;
+  }
+  if (p.phase == PHASE_SYNC && !p.inFlight.empty()) {
+    uint64_t deadline = p.inFlight.front().queuedUs + (uint64_t)o.commandTimeoutMs * 1000;
+    if (now >= deadline) {
+      finish(p, "no reply to " + p.inFlight.front().text);
+      return 0;
+    }
+    return (uint32_t)((deadline - now) / 1000) + 1;
+  }
+  return 1000;
+}
+
+std::vector<ProvisionResult> provisionClocks(const std::vector<std::string>& ports,
+                                             const ClockConfig& config,
+                                             const ProvisionOptions& options) {
+  std::vector<Port> all(ports.size());
+  for (size_t i = 0; i < ports.size(); i++) {
+    Port& p = all[i];
+    p.result.port = ports[i];
+    p.result.ok = false;
+    p.result.readyMs = p.result.syncMs = p.result.totalMs = p.result.rttMaxMs = 0;
+    p.result.replies = 0;
+    p.phase = PHASE_PROBE;
+    p.verbosity = 2;
+    p.inFlightBytes = 0;
+    p.lastProbeUs = p.syncStartUs = 0;
+    p.openedUs = nowUs();
+    std::string error;
+    p.fd = openSerial(ports[i], error);
+    if (p.fd < 0) finish(p, error);
+  }
+
+  std::vector<struct pollfd> fds;
+  std::vector<Port*> polled;
+  for (;;) {
+    fds.clear();
+    polled.clear();
+    uint32_t waitMs = 1000;
+    for (Port& p : all) {
+      if (p.phase == PHASE_DONE) continue;
+      uint32_t due = checkTimers(p, options);
+      if (p.phase == PHASE_DONE) continue;
+      if (due < waitMs) waitMs = due;
+      struct pollfd pfd;
+      pfd.fd = p.fd;
+      pfd.events = POLLIN | (p.tx.empty() ? 0 : POLLOUT);
+      pfd.revents = 0;
+      fds.push_back(pfd);
+      polled.push_back(&p);
+    }
+    if (fds.empty()) break;
+
+    int n = poll(fds.data(), fds.size(), (int)waitMs);
+    if (n < 0 && errno != EINTR) {
+      for (Port* p : polled) finish(*p, std::string("poll: ") + strerror(errno));
+      break;
+    }
+    for (size_t i = 0; n > 0 && i < fds.size(); i++) {
+      Port& p = *polled[i];
+      if (fds[i].revents & POLLIN) readPort(p, config);
+      if (p.phase != PHASE_DONE && (fds[i].revents & (POLLHUP | POLLERR | POLLNVAL)) && !(fds[i].revents & POLLIN)) {
+        finish(p, "port closed");  // Unplugged
+      }
+      if (p.phase != PHASE_DONE && (fds[i].revents & POLLOUT)) writePort(p);
+    }
+    // Commands queued by replies go out without waiting for the next POLLOUT
+    for (Port* p : polled) {
+      if (p->phase != PHASE_DONE && !p->tx.empty()) writePort(*p);
+    }
+  }
+
+  std::vector<ProvisionResult> results;
+  for (const Port& p : all) results.push_back(p.result);
+  return results;
+}
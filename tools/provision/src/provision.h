@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Host-side batch provisioning: sync many clocks at once over their serial
+// ports with the text protocol (QV, Z, D, T, F, B, S, N, Y, QF, QS). Every port
+// is a non-blocking descriptor with its own command queue and reply matching,
+// and one poll() loop serves them all, so a batch takes about as long as its
+// slowest clock. POSIX only (termios); the firmware sources are not needed.
+//
+// Per clock:
+//   1. QV every PROVISION_PROBE_INTERVAL_MS until the device answers (opening
+//      the port resets a Nano: bootloader, then setup()). The level tells
+//      whether set commands will reply (V0: they are followed by P instead).
+//   2. Z0, then the host's UTC date and time with D and T, then Z<tz>: the RTC
+//      keeps UTC, so this needs no knowledge of the zone's offset or DST.
+//   3. F, B, S, N, Y, then QF and QS, which must report the requested values.
+// Commands are pipelined while they fit the device's serial receive buffer;
+// its replies come back in order. The first ERR or missing reply fails the clock.
+
+#define PROVISION_RX_WINDOW          63    // Device receive buffer: 64 bytes, one slot kept free
+#define PROVISION_COMMAND_TIMEOUT_MS 1000
+#define PROVISION_BOOT_TIMEOUT_MS    5000  // Bootloader and setup() after the port opens
+#define PROVISION_PROBE_INTERVAL_MS  250
+
+// Settings written to every clock (same values and ranges as F, Z, B, S, N, Y)
+struct ClockConfig {
+  uint8_t format12h;
+  uint8_t tzId;
+  uint8_t brightness;
+  uint8_t scheduleEnabled;
+  uint8_t dimHour;
+  uint8_t dimMinute;
+  uint8_t dimBrightness;
+  uint8_t brightHour;
+  uint8_t brightMinute;
+  uint8_t brightBrightness;
+};
+
+struct ProvisionOptions {
+  uint32_t commandTimeoutMs;
+  uint32_t bootTimeoutMs;
+};
+
+struct ProvisionResult {
+  std::string port;
+  bool ok;
+  std::string error;     // Why the clock failed: open error, ERR reply, missing reply, mismatch
+  uint32_t readyMs;      // Port open until the first reply
+  uint32_t syncMs;       // First sync command until the last reply
+  uint32_t totalMs;
+  uint16_t replies;      // Sync commands acknowledged
+  uint32_t rttMaxMs;     // Slowest reply, from queueing the command
+  std::string schedule;  // QS reply fields after the sync
+};
+
+// Firmware factory settings (settingsDefaults()): 24h, UTC, brightness 5,
+// dim 22:00 at 1, bright 07:00 at 5, schedule off
+ClockConfig defaultClockConfig();
+ProvisionOptions defaultProvisionOptions();
+
+// "enabled=1,dim=22:00:1,bright=07:00:5", as QS reports config
+std::string expectedSchedule(const ClockConfig& config);
+
+// Sync all ports concurrently. One result per port, in the same order.
+std::vector<ProvisionResult> provisionClocks(const std::vector<std::string>& ports,
+                                             const ClockConfig& config,
+                                             const ProvisionOptions& options);
@@ -0,0 +1,101 @@
+// Streaming reader for the clock's serial output: text lines and binary reply
+// frames (0xA5 LEN BODY CRC_HI CRC_LO, see src/frame.h) share one port. Every
+// byte is examined once. A line collects in a fixed buffer that is rewound at
+// each terminator and decoded by one persistent TextDecoder, so a burst of DBG
+// lines costs the same per byte as a single line.
+//
+// Loaded by index.html; bench/bench_serial_reader.js drives it from node.
+
+(function (root) {
+    const FRAME_SYNC = 0xA5;
+    const FRAME_OVERHEAD = 4;  // SYNC, LEN, CRC16
+    const CR = 0x0D;
+    const LF = 0x0A;
+
+    class SerialLineReader {
+        // onLine(text): a complete line, trimmed, never empty
+        // onFrame(bytes): a complete frame (SYNC..CRC_LO), CRC not checked yet
+        constructor({ onLine, onFrame, maxLine = 256, maxFrameBody = 24 }) {
+            this.onLine = onLine;
+            this.onFrame = onFrame;
+            this.maxFrameBody = maxFrameBody;
+            this.decoder = new TextDecoder();
+            this.line = new Uint8Array(maxLine);
+            this.lineLen = 0;
+            this.lineOverflow = false;  // Dropping the rest of a line longer than maxLine
+            this.frame = new Uint8Array(maxFrameBody + FRAME_OVERHEAD);
+            this.frameLen = 0;          // Frame bytes so far; 0 when not inside a frame
+            this.bytes = 0;             // Bytes processed, including the one being handled
+            this.lines = 0;
+            this.frames = 0;
+            this.dropped = 0;           // Lines and frames lost to overflow, bad length or reset()
+        }
+
+        push(chunk) {
+            const line = this.line;
+            for (let i = 0; i < chunk.length; i++) {
+                const byte = chunk[i];
+                this.bytes++;
+
+                if (this.frameLen > 0) {
+                    this.pushFrameByte(byte);
+                    continue;
+                }
+                if (byte === LF || byte === CR) {
+                    this.endLine();
+                    continue;
+                }
+                if (byte === FRAME_SYNC && this.lineLen === 0 && !this.lineOverflow) {
+                    this.frame[0] = byte;
+                    this.frameLen = 1;
+                    continue;
+                }
+                if (this.lineLen < line.length) {
+                    line[this.lineLen++] = byte;
+                } else if (!this.lineOverflow) {
+                    this.lineOverflow = true;
+                    this.dropped++;
+                }
+            }
+        }
+
+        pushFrameByte(byte) {
+            this.frame[this.frameLen++] = byte;
+            if (this.frameLen === 2 && (byte === 0 || byte > this.maxFrameBody)) {
+                // Impossible length: the firmware never sends it, drop the frame start
+                this.frameLen = 0;
+                this.dropped++;
+            } else if (this.frameLen > 2 && this.frameLen === this.frame[1] + FRAME_OVERHEAD) {
+                const frame = this.frame.slice(0, this.frameLen);
+                this.frameLen = 0;
+                this.frames++;
+                this.onFrame(frame);
+            }
+        }
+
+        endLine() {
+            const len = this.lineLen;
+            const overflow = this.lineOverflow;
+            this.lineLen = 0;
+            this.lineOverflow = false;
+            if (len === 0 || overflow) return;  // CR LF pairs end one line
+            const text = this.decoder.decode(this.line.subarray(0, len)).trim();
+            if (!text) return;
+            this.lines++;
+            this.onLine(text);
+        }
+
+        // Forget a partial line or frame, e.g. after the browser dropped input
+        reset() {
+            if (this.lineLen > 0 || this.frameLen > 0) this.dropped++;
+            this.lineLen = 0;
+            this.lineOverflow = false;
+            this.frameLen = 0;
+        }
+    }
+
+    root.SerialLineReader = SerialLineReader;
+    if (typeof module !== 'undefined' && module.exports) {
+        module.exports = { SerialLineReader };
+    }
+})(typeof globalThis !== 'undefined' ? globalThis : this);